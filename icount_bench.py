@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# Runs the firmware built with APP_MODE_ICOUNT_BENCH=1 under QEMU with -icount
+# and writes the per-region instruction/cycle counts to a JSON file.
+#
+#   idf.py build && python icount_bench.py -o icount_results.json
+#   python icount_bench.py -o new.json --baseline icount_results.json
+#
+# With -icount the ESP32 CCOUNT follows the executed instruction count, so
+# counts are exact; any difference against the baseline is a real change.
+import argparse
+import json
+import os
+import queue
+import re
+import subprocess
+import sys
+import threading
+import time
+from typing import Dict
+from typing import List
+from typing import Optional
+
+REGION_RE = re.compile(r'\[ICOUNT\] (\{.*\})')
+END_MARK = '[ICOUNT] fim'
+
+
+def make_flash_image(build_dir: str) -> str:
+    image = os.path.join(build_dir, 'qemu_flash.bin')
+    subprocess.run(
+        [
+            sys.executable, '-m', 'esptool', '--chip', 'esp32', 'merge_bin',
+            '--fill-flash-size', '4MB', '-o', image, '@flash_args',
+        ],
+        cwd=build_dir,
+        check=True,
+    )
+    return image
+
+
+def qemu_command(image: str, shift: int) -> List[str]:
+    return [
+        'qemu-system-xtensa', '-M', 'esp32', '-m', '4M', '-nographic',
+        '-icount', f'shift={shift},align=off,sleep=off',
+        '-drive', f'file={image},if=mtd,format=raw',
+        '-global', 'driver=timer.esp32.timg,property=wdt_disable,value=true',
+    ]
+
+
+def run_qemu(cmd: List[str], timeout_s: float) -> Dict[str, dict]:
+    results: Dict[str, dict] = {}
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace')
+    assert proc.stdout is not None
+    stdout = proc.stdout
+
+    # A hung QEMU prints nothing, so the deadline cannot be checked between
+    # lines of a blocking read: a reader thread feeds a queue instead.
+    lines: 'queue.Queue[Optional[str]]' = queue.Queue()
+
+    def reader() -> None:
+        for line in stdout:
+            lines.put(line)
+        lines.put(None)  # EOF
+
+    threading.Thread(target=reader, daemon=True).start()
+    deadline = time.monotonic() + timeout_s
+    try:
+        while True:
+            try:
+                line = lines.get(timeout=max(0.0, deadline - time.monotonic()))
+            except queue.Empty:
+                raise TimeoutError(f'QEMU did not finish the icount benchmark in {timeout_s:.0f} s') from None
+            if line is None:
+                raise RuntimeError(f'QEMU exited (code {proc.poll()}) before "{END_MARK}"; '
+                                   f'only {len(results)} region(s) were read')
+            m = REGION_RE.search(line)
+            if m:
+                entry = json.loads(m.group(1))
+                results[entry.pop('region')] = entry
+            if END_MARK in line:
+                break
+    finally:
+        proc.kill()
+        proc.wait(timeout=10)
+    return results
+
+
+def git_revision() -> Optional[str]:
+    try:
+        return subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], capture_output=True, text=True,
+                              check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def compare(results: Dict[str, dict], baseline: Dict[str, dict]) -> int:
+    changed = 0
+    for region, entry in sorted(results.items()):
+        old = baseline.get(region)
+        if old is None:
+            print(f'{region:20s} {entry["cycles"]:>12d}   (new)')
+            continue
+        delta = entry['cycles'] - old['cycles']
+        if delta:
+            changed += 1
+        pct = 100.0 * delta / old['cycles'] if old['cycles'] else 0.0
+        print(f'{region:20s} {entry["cycles"]:>12d} {delta:+12d} ({pct:+.2f}%)')
+    return changed
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description='QEMU -icount benchmark runner')
+    parser.add_argument('--build-dir', default='build')
+    parser.add_argument('-o', '--output', default='icount_results.json')
+    parser.add_argument('--baseline', help='previous results file to diff against')
+    parser.add_argument('--shift', type=int, default=0, help='QEMU -icount shift (1 insn = 2^shift ns)')
+    parser.add_argument('--timeout', type=float, default=300.0)
+    parser.add_argument('--fail-on-change', action='store_true', help='exit 1 if any region count changed')
+    args = parser.parse_args()
+
+    image = make_flash_image(args.build_dir)
+    results = run_qemu(qemu_command(image, args.shift), args.timeout)
+    if not results:
+        print('no [ICOUNT] regions found – was the firmware built with APP_MODE_ICOUNT_BENCH=1?')
+        return 2
+
+    with open(args.output, 'w') as f:
+        json.dump({'revision': git_revision(), 'icount_shift': args.shift, 'regions': results}, f, indent=2)
+    print(f'{len(results)} regions written to {args.output}')
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)['regions']
+        changed = compare(results, baseline)
+        if changed and args.fail_on_change:
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
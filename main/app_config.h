@@ -0,0 +1,234 @@
+#pragma once
+
+/* ==========================
+ *  CONFIGURAÇÕES GERAIS
+ *  Compartilhadas entre app_main e os módulos auxiliares (C e C++).
+ * ========================== */
+
+#include <stdio.h>
+
+#include "sdkconfig.h"
+
+/* Modos de build alternativos (0 = pipeline normal) */
+#ifndef APP_MODE_IPC_BENCH
+#define APP_MODE_IPC_BENCH       0   // microbenchmark de primitivas IPC (ipc_bench.c)
+#endif
+#ifndef APP_MODE_ICOUNT_BENCH
+#define APP_MODE_ICOUNT_BENCH    0   // contagem de instruções sob QEMU -icount (icount_bench.c)
+#endif
+#ifndef APP_MODE_SOAK
+#define APP_MODE_SOAK            0   // pipeline normal + detecção de deriva (soak.c)
+#endif
+#ifndef APP_MODE_COROUTINE
+#define APP_MODE_COROUTINE       0   // GERADOR/RX/LOG como corrotinas numa tarefa (coro_pipeline.c)
+#endif
+#ifndef APP_MODE_CYCLIC
+#define APP_MODE_CYCLIC          0   // executivo cíclico por tempo, sem preempção (cyclic.c)
+#endif
+#ifndef APP_MODE_PARALLEL
+#define APP_MODE_PARALLEL        0   // pool com roubo de trabalho: 1 worker x 1 por núcleo (parallel.c)
+#endif
+#ifndef APP_MODE_SHARDED
+#define APP_MODE_SHARDED         0   // K pipelines independentes roteadas por chave (shard_pipeline.c)
+#endif
+#ifndef APP_MODE_FAIR
+#define APP_MODE_FAIR            0   // fluxos com filas próprias e escalonamento DRR na RX (fair_pipeline.c)
+#endif
+#ifndef APP_MODE_LANES
+#define APP_MODE_LANES           0   // faixa urgente + faixa bulk com queue set (lane_pipeline.c)
+#endif
+#ifndef APP_MODE_STRESS
+#define APP_MODE_STRESS          0   // vazão de saturação GERADOR→RX (stress.c)
+#endif
+
+/* Injeção de falhas + MTTR (fault.c): console "fault <nome>" e agenda */
+#ifndef APP_FAULT_INJECTION
+#define APP_FAULT_INJECTION      0
+#endif
+#ifndef APP_FAULT_SCHEDULE
+#define APP_FAULT_SCHEDULE       0   // injeta a sequência de k_schedule sozinho
+#endif
+
+/* Supervisor e logger como timers de software + tarefa de serviço
+ * compartilhada com fila de trabalho adiado (svc.h), em vez de duas tarefas */
+#ifndef APP_SERVICE_TIMERS
+#define APP_SERVICE_TIMERS       0
+#endif
+
+/* Tempo virtual determinístico (só target linux, ver port/linux/vclock.c) */
+#ifndef APP_VIRTUAL_TIME
+#define APP_VIRTUAL_TIME         0
+#endif
+#if APP_VIRTUAL_TIME && !CONFIG_IDF_TARGET_LINUX
+#error "APP_VIRTUAL_TIME só é suportado no target linux"
+#endif
+/* O relógio virtual só anda quando todas as tarefas bloqueiam: um modo que
+ * ocupa a CPU sem bloquear congela o tempo (como o wdt_starve, ver fault.c) */
+#if APP_VIRTUAL_TIME && APP_MODE_STRESS
+#error "APP_VIRTUAL_TIME é incompatível com APP_MODE_STRESS (o GERADOR nunca bloqueia)"
+#endif
+#if APP_VIRTUAL_TIME && APP_FAULT_INJECTION && APP_FAULT_SCHEDULE
+#error "APP_VIRTUAL_TIME é incompatível com APP_FAULT_SCHEDULE (a agenda injeta wdt_starve, que prende a CPU)"
+#endif
+
+/* Plataforma: o target linux (port POSIX) tem um único núcleo e não tem
+ * esp_ringbuf; lá o contador de ciclos é emulado em ns (1 "ciclo" = 1 ns) */
+#if defined(CONFIG_FREERTOS_NUMBER_OF_CORES) && CONFIG_FREERTOS_NUMBER_OF_CORES > 1
+#define APP_NUM_CORES      2
+#define APP_PIPE_CORE      1   // núcleo das tarefas da pipeline
+#else
+#define APP_NUM_CORES      1
+#define APP_PIPE_CORE      0
+#endif
+
+#if CONFIG_IDF_TARGET_LINUX
+#define APP_HAS_RINGBUF    0
+#define APP_CPU_FREQ_MHZ   1000
+#else
+#define APP_HAS_RINGBUF    1
+#define APP_CPU_FREQ_MHZ   CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#endif
+
+/* Identificação obrigatória em TODOS os prints oi */
+#define STUDENT_PREFIX "{Pedro Modesto Mesquita-RM:87880} "
+#define PRINTF(fmt, ...) printf(STUDENT_PREFIX fmt, ##__VA_ARGS__)
+
+/* Prioridades (maior número = maior prioridade) */
+#define GEN_TASK_PRIO      6   // Módulo 1 – Geração de Dados
+#define RX_TASK_PRIO       5   // Módulo 2 – Recepção/Transmissão
+#define SUP_TASK_PRIO      4   // Módulo 3 – Supervisão
+#define LOG_TASK_PRIO      2   // Extra – Log periódico (opcional)
+
+/* Tamanhos de pilha (em words) */
+#define GEN_STACK_WORDS    4096
+#define RX_STACK_WORDS     4096
+#define SUP_STACK_WORDS    4096
+#define LOG_STACK_WORDS    3072
+#define SVC_STACK_WORDS    4096  // tarefa de serviço (APP_SERVICE_TIMERS)
+
+/* Fila */
+#define QUEUE_LEN          10
+#define STRESS_MAX_DEPTH   64  // maior profundidade da varredura do modo stress
+
+/* Capacidade física do canal; no modo stress a profundidade efetiva é
+ * limitada em tempo de execução (pipe_set_depth_limit) */
+#if APP_MODE_STRESS
+#define PIPE_CAPACITY      STRESS_MAX_DEPTH
+#else
+#define PIPE_CAPACITY      QUEUE_LEN
+#endif
+
+/* Backend do canal da pipeline (ver channel.hpp):
+ * 0 = fila FreeRTOS, 1 = anel SPSC lock-free, 2 = esp_ringbuf (não no linux) */
+#ifndef APP_CHANNEL_BACKEND
+#define APP_CHANNEL_BACKEND      0
+#endif
+
+/* Shards (APP_MODE_SHARDED): cada um com fila e consumidor próprios;
+ * SHARD_CORE(i) escolhe o núcleo do consumidor do shard i */
+#ifndef APP_SHARDS
+#define APP_SHARDS               4
+#endif
+#ifndef SHARD_CORE
+#define SHARD_CORE(i)            ((APP_PIPE_CORE + (i)) % APP_NUM_CORES)
+#endif
+
+/* Escalonamento justo na RX (APP_MODE_FAIR): peso de cada fluxo = itens
+ * que ele pode enviar por rodada do DRR quando todos têm fila */
+#define FAIR_STREAMS             3
+#ifndef FAIR_WEIGHTS
+#define FAIR_WEIGHTS             { 2, 1, 1 }
+#endif
+
+/* Faixas de prioridade (APP_MODE_LANES): a urgente é sempre drenada
+ * primeiro; depois de LANE_URGENT_BURST urgentes seguidos com bulk
+ * esperando, um bulk passa (proteção contra inanição) */
+#define LANE_URGENT_LEN          4
+#define LANE_URGENT_BURST        4
+
+/* Perfil de tráfego da fonte (traffic.h): 0 constante, 1 Poisson,
+ * 2 rajadas on/off, 3 diurno senoidal, 4 degraus */
+#ifndef APP_TRAFFIC_PROFILE
+#define APP_TRAFFIC_PROFILE      0
+#endif
+#define TRAFFIC_BURST_ON_MS      2000   // perfil on/off
+#define TRAFFIC_BURST_OFF_MS     2500
+#ifndef APP_TRAFFIC_SEED
+#define APP_TRAFFIC_SEED         12345u
+#endif
+
+/* Temporizações */
+#define GEN_PERIOD_MS            150
+#define GEN_MAX_SLEEP_MS         1000   // maior fatia de sono do gerador entre batidas
+#define RX_TIMEOUT_MS            1000
+#define SUP_PERIOD_MS            1500
+#define LOG_PERIOD_MS            1000
+#define RX_PROC_DELAY_MS         50   // folga de "processamento" por item na RX
+#define STALL_TICKS(ms)          pdMS_TO_TICKS(ms)
+
+/* Timeout da RX estimado do intervalo entre chegadas (rx_rto.h);
+ * RX_TIMEOUT_MS vira o valor inicial e o teto */
+#ifndef APP_RX_ADAPTIVE_TIMEOUT
+#define APP_RX_ADAPTIVE_TIMEOUT  1
+#endif
+#define RX_RTO_MIN_MS            200
+
+/* Recuperação moderada da RX: 1 = preserva os itens em voo (pipe_recover),
+ * 0 = descarta tudo (pipe_reset) */
+#ifndef APP_RX_PRESERVE_ON_RECOVERY
+#define APP_RX_PRESERVE_ON_RECOVERY  1
+#endif
+
+/* Controle de fluxo por créditos GERADOR→RX (flow.h): a fonte para ao
+ * chegar em FLOW_HIGH_WM itens em voo e só volta com FLOW_LOW_WM */
+#ifndef APP_FLOW_CONTROL
+#define APP_FLOW_CONTROL         1
+#endif
+#define FLOW_HIGH_WM             (QUEUE_LEN - 2)
+#define FLOW_LOW_WM              (QUEUE_LEN / 2)
+
+/* Saídas da RX (sink.h): cada sink com buffer limitado e tarefa própria.
+ * 0 = a RX imprime direto, como antes */
+#ifndef APP_SINKS
+#define APP_SINKS                0
+#endif
+#define SINK_BUF_LEN             16
+#define SINK_TASK_PRIO           3   // abaixo da RX: sink lento nunca a segura
+#define SINK_STACK_WORDS         3072
+
+/* Barramento pub/sub sem cópia (bus.h): a RX publica cada registro e o
+ * supervisor o status; agregador, auditor e monitor assinam, e com
+ * APP_SINKS os sinks também (recebem handles, sem cópia na RX) */
+#ifndef APP_BUS
+#define APP_BUS                  0
+#endif
+#define BUS_POOL_SIZE            80  // >= soma das filas dos assinantes + folga (bus.c)
+#define BUS_SUB_DEPTH            8   // handles pendentes por assinante
+#define BUS_TASK_PRIO            3
+#define BUS_STACK_WORDS          3072
+
+/* Escalonamento de reações na RX, em timeouts consecutivos (cada um dura o
+ * timeout estimado: a detecção acompanha o ritmo real dos dados) */
+#define RX_WARN_THRESHOLD        2   // n° de timeouts para aviso leve
+#define RX_RECOVER_SOFT          3   // tentativa leve (limpeza de estado)
+#define RX_RECOVER_RESET_Q       4   // reset da fila
+#define RX_FAIL_THRESHOLD        5   // encerra tarefa para o supervisor recriar
+
+/* Watchdog (Task WDT) */
+#define WDT_TIMEOUT_SECONDS      5
+#ifndef APP_WDT_PROXY
+#define APP_WDT_PROXY            1   // estágios alimentam via wdt_proxy.c
+#endif
+
+/* Watchdog de software por estágio (swdt.h): prazo = espera prevista do
+ * estágio + SWDT_SLACK_PCT% + SWDT_MIN_SLACK_MS; ações SWDT_ACT_* */
+#ifndef APP_SWDT
+#define APP_SWDT                 1
+#endif
+#define SWDT_CHECK_MS            20
+#define SWDT_SLACK_PCT           50
+#define SWDT_MIN_SLACK_MS        30
+#define SWDT_ACTIONS_GEN         (SWDT_ACT_LOG | SWDT_ACT_RESTART)
+#define SWDT_ACTIONS_RX          (SWDT_ACT_LOG | SWDT_ACT_RESTART)
+#define SWDT_ACTIONS_SUP         (SWDT_ACT_LOG | SWDT_ACT_PANIC)   // ninguém supervisiona o supervisor
+#define SWDT_ACTIONS_LOG         (SWDT_ACT_LOG)
@@ -0,0 +1,153 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "bus.h"
+
+#if APP_BUS
+
+static bus_msg_t s_pool[BUS_POOL_SIZE];
+static QueueHandle_t s_free = NULL;          // bus_msg_t* livres
+/* Publicadores diferentes (RX, supervisor) podem se atropelar nestes dois
+ * contadores de telemetria; a imprecisão é aceitável */
+static volatile uint32_t s_min_free = BUS_POOL_SIZE;
+static volatile uint32_t s_alloc_fail = 0;
+
+static bus_sub_t s_subs[BUS_TOPIC_COUNT][BUS_MAX_SUBS];
+static int s_n_subs[BUS_TOPIC_COUNT];
+
+/* Buffers que as filas dos assinantes podem prender ao mesmo tempo; o
+ * resto do pool fica para os publicadores (RX, supervisor) alocarem */
+#define BUS_POOL_SPARE   4
+static uint32_t s_pinned = 0;
+
+bool bus_init(void) {
+    s_free = xQueueCreate(BUS_POOL_SIZE, sizeof(bus_msg_t *));
+    if (!s_free) {
+        return false;
+    }
+    for (int i = 0; i < BUS_POOL_SIZE; i++) {
+        bus_msg_t *m = &s_pool[i];
+        xQueueSend(s_free, &m, 0);
+    }
+    return true;
+}
+
+bus_sub_t *bus_subscribe(bus_topic_t topic, const char *name, uint32_t depth, bool drop_oldest) {
+    if (s_n_subs[topic] >= BUS_MAX_SUBS) {
+        return NULL;
+    }
+    if (s_pinned + depth > BUS_POOL_SIZE - BUS_POOL_SPARE) {
+        PRINTF("[BUS] %s: pool pequeno para mais %u handles pendentes.\n", name, (unsigned)depth);
+        return NULL;
+    }
+    bus_sub_t *sub = &s_subs[topic][s_n_subs[topic]];
+    sub->name = name;
+    sub->drop_oldest = drop_oldest;
+    sub->q = xQueueCreate(depth, sizeof(bus_msg_t *));
+    if (!sub->q) {
+        return NULL;
+    }
+    s_pinned += depth;
+    s_n_subs[topic]++;
+    return sub;
+}
+
+bus_msg_t *bus_alloc(TickType_t wait) {
+    bus_msg_t *m = NULL;
+    if (xQueueReceive(s_free, &m, wait) != pdTRUE) {
+        s_alloc_fail++;
+        return NULL;
+    }
+    uint32_t free_now = uxQueueMessagesWaiting(s_free);
+    if (free_now < s_min_free) {
+        s_min_free = free_now;
+    }
+    atomic_store_explicit(&m->refs, 1, memory_order_relaxed);
+    return m;
+}
+
+void bus_release(bus_msg_t *msg) {
+    /* acq_rel: as leituras do payload acontecem antes de o buffer voltar */
+    if (atomic_fetch_sub_explicit(&msg->refs, 1, memory_order_acq_rel) == 1) {
+        xQueueSend(s_free, &msg, 0);
+    }
+}
+
+void bus_publish(bus_msg_t *msg, bus_topic_t topic) {
+    msg->topic = topic;
+    msg->t_pub_us = (uint32_t)esp_timer_get_time();
+
+    /* Uma referência por assinante antes de qualquer um poder soltar */
+    int n = s_n_subs[topic];
+    atomic_fetch_add_explicit(&msg->refs, (unsigned)n, memory_order_relaxed);
+    for (int i = 0; i < n; i++) {
+        bus_sub_t *sub = &s_subs[topic][i];
+        if (xQueueSend(sub->q, &msg, 0) == pdTRUE) {
+            sub->delivered++;
+            continue;
+        }
+        sub->dropped++;
+        bus_msg_t *old = NULL;
+        if (sub->drop_oldest && xQueueReceive(sub->q, &old, 0) == pdTRUE) {
+            bus_release(old);   // abre vaga para o mais novo
+            if (xQueueSend(sub->q, &msg, 0) == pdTRUE) {
+                sub->delivered++;
+                continue;
+            }
+        }
+        bus_release(msg);       // referência deste assinante
+    }
+    bus_release(msg);   // referência do publicador
+}
+
+bus_msg_t *bus_receive(bus_sub_t *sub, TickType_t wait) {
+    bus_msg_t *m = NULL;
+    if (xQueueReceive(sub->q, &m, wait) != pdTRUE) {
+        return NULL;
+    }
+    uint32_t lag = (uint32_t)esp_timer_get_time() - m->t_pub_us;
+    sub->lag_us = lag;
+    if (lag > sub->lag_max_us) {
+        sub->lag_max_us = lag;
+    }
+    return m;
+}
+
+uint32_t bus_pool_free(void) {
+    return s_free ? uxQueueMessagesWaiting(s_free) : 0;
+}
+
+uint32_t bus_pool_min_free(void) {
+    return s_min_free;
+}
+
+uint32_t bus_alloc_failures(void) {
+    return s_alloc_fail;
+}
+
+int bus_sub_count(void) {
+    int n = 0;
+    for (int t = 0; t < BUS_TOPIC_COUNT; t++) {
+        n += s_n_subs[t];
+    }
+    return n;
+}
+
+const bus_sub_t *bus_sub_get(int i) {
+    for (int t = 0; t < BUS_TOPIC_COUNT; t++) {
+        if (i < s_n_subs[t]) {
+            return &s_subs[t][i];
+        }
+        i -= s_n_subs[t];
+    }
+    return NULL;
+}
+
+#endif // APP_BUS
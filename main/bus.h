@@ -0,0 +1,92 @@
+#pragma once
+
+/* ==========================
+ *  Barramento publish/subscribe sem cópia (APP_BUS)
+ *  Mensagens vivem num pool fixo de buffers com contagem de referências.
+ *  O publicador pega um buffer (bus_alloc), preenche o payload no lugar
+ *  e publica num tópico; cada assinante recebe o ponteiro na sua fila
+ *  (4 bytes no ESP32, 8 no target linux), não uma cópia. Publicar custa
+ *  O(assinantes) envios de ponteiro, independente do tamanho do payload.
+ *  Cada assinante chama bus_release ao terminar; o último devolve o
+ *  buffer ao pool.
+ *
+ *  Fila de um assinante cheia: só ele perde uma mensagem (contado) – a
+ *  nova ou, com drop_oldest, a mais antiga da fila. Cada assinante mede o
+ *  atraso publicação → recepção (lag).
+ *
+ *  Cada handle na fila de um assinante prende um buffer do pool; a soma
+ *  das profundidades das filas fica abaixo de BUS_POOL_SIZE (bus_subscribe
+ *  recusa o excesso), então assinantes travados não secam o pool.
+ * ========================== */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BUS_PAYLOAD_MAX     32
+#define BUS_MAX_SUBS        6     // por tópico (3 sinks + agregador + auditor)
+
+typedef enum {
+    BUS_TOPIC_RECORD = 0,    // pipe_item_t processado pela RX
+    BUS_TOPIC_STATUS,        // bus_status_t de cada rodada do supervisor
+    BUS_TOPIC_COUNT
+} bus_topic_t;
+
+typedef struct {
+    uint32_t free_heap;
+    uint32_t restarts;
+    uint8_t  shed_level;
+} bus_status_t;
+
+typedef struct {
+    atomic_uint refs;
+    bus_topic_t topic;
+    uint32_t t_pub_us;
+    uint8_t  payload[BUS_PAYLOAD_MAX];
+} bus_msg_t;
+
+typedef struct {
+    const char *name;
+    QueueHandle_t q;              // bus_msg_t*
+    bool drop_oldest;             // fila cheia: descarta o mais antigo, não o novo
+    volatile uint32_t delivered;  // escritor: publicador
+    volatile uint32_t dropped;    // escritor: publicador (fila cheia)
+    volatile uint32_t lag_us;     // escritor: assinante (último publicação → recepção)
+    volatile uint32_t lag_max_us;
+} bus_sub_t;
+
+bool bus_init(void);
+/* Assina antes de publicar; devolve NULL sem espaço (assinantes do tópico
+ * ou buffers do pool para `depth` handles pendentes) */
+bus_sub_t *bus_subscribe(bus_topic_t topic, const char *name, uint32_t depth, bool drop_oldest);
+
+/* Buffer livre com uma referência (do publicador); NULL se o pool secar */
+bus_msg_t *bus_alloc(TickType_t wait);
+/* Entrega a todos os assinantes do tópico e solta a referência do publicador */
+void bus_publish(bus_msg_t *msg, bus_topic_t topic);
+bus_msg_t *bus_receive(bus_sub_t *sub, TickType_t wait);
+void bus_release(bus_msg_t *msg);
+
+/* Contadores do pool */
+uint32_t bus_pool_free(void);
+uint32_t bus_pool_min_free(void);
+uint32_t bus_alloc_failures(void);
+
+/* Assinantes embutidos (bus_subs.c): agregador, auditor e monitor; os
+ * sinks (sink.h) também assinam BUS_TOPIC_RECORD quando APP_BUS */
+bool bus_subs_start(void);
+int  bus_sub_count(void);
+const bus_sub_t *bus_sub_get(int i);
+
+#ifdef __cplusplus
+}
+#endif
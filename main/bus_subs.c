@@ -0,0 +1,129 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "shed.h"
+#include "bus.h"
+
+#if APP_BUS
+
+#define AGG_REPORT_MS     5000
+
+_Static_assert(sizeof(pipe_item_t) <= BUS_PAYLOAD_MAX, "pipe_item_t não cabe no payload");
+_Static_assert(sizeof(bus_status_t) <= BUS_PAYLOAD_MAX, "bus_status_t não cabe no payload");
+
+/* ==========================
+ *  Assinante genérico: recebe o handle, chama o tratador, solta
+ * ========================== */
+typedef void (*bus_handler_t)(const bus_msg_t *msg);
+
+typedef struct {
+    bus_sub_t *sub;
+    bus_handler_t handler;
+} bus_runner_t;
+
+static bus_runner_t s_runners[3];
+static int s_n_runners = 0;
+
+static void task_bus_sub(void *pv) {
+    const bus_runner_t *r = (const bus_runner_t *)pv;
+    for (;;) {
+        bus_msg_t *m = bus_receive(r->sub, portMAX_DELAY);
+        if (m) {
+            r->handler(m);
+            bus_release(m);
+        }
+    }
+}
+
+static bool spawn(bus_topic_t topic, const char *name, bus_handler_t handler) {
+    bus_runner_t *r = &s_runners[s_n_runners];
+    r->sub = bus_subscribe(topic, name, BUS_SUB_DEPTH, false);
+    r->handler = handler;
+    if (!r->sub) {
+        return false;
+    }
+    s_n_runners++;
+    return xTaskCreatePinnedToCore(task_bus_sub, name, BUS_STACK_WORDS, r,
+                                   BUS_TASK_PRIO, NULL, APP_PIPE_CORE) == pdPASS;
+}
+
+/* ==========================
+ *  Agregador – contagem, mín/máx/média por janela
+ * ========================== */
+static void on_record_aggregate(const bus_msg_t *msg) {
+    static uint32_t n = 0;
+    static int64_t sum = 0;
+    static int32_t vmin = INT32_MAX, vmax = INT32_MIN;
+    static int64_t window_start = 0;
+
+    const pipe_item_t *item = (const pipe_item_t *)msg->payload;
+    n++;
+    sum += item->value;
+    vmin = item->value < vmin ? item->value : vmin;
+    vmax = item->value > vmax ? item->value : vmax;
+
+    int64_t now = esp_timer_get_time();
+    if (window_start == 0) {
+        window_start = now;
+    } else if (now - window_start >= AGG_REPORT_MS * 1000) {
+        PRINTF("[AGG] janela %u ms: n=%" PRIu32 " min=%" PRId32 " max=%" PRId32 " média=%" PRId32 "\n",
+               (unsigned)AGG_REPORT_MS, n, vmin, vmax, (int32_t)(sum / n));
+        n = 0;
+        sum = 0;
+        vmin = INT32_MAX;
+        vmax = INT32_MIN;
+        window_start = now;
+    }
+}
+
+/* ==========================
+ *  Auditor – continuidade da sequência (descartes no caminho)
+ *  Salto para trás = gerador recriado (recomeça do zero): ressincroniza
+ *  em vez de contar lacuna
+ * ========================== */
+static void on_record_audit(const bus_msg_t *msg) {
+    static int32_t last = -1;
+    static uint32_t gaps = 0;
+
+    const pipe_item_t *item = (const pipe_item_t *)msg->payload;
+    if (last >= 0 && item->value <= last) {
+        PRINTF("[AUDIT] Sequência reiniciada %" PRId32 " -> %" PRId32 " – ressincronizando.\n",
+               last, item->value);
+    } else if (last >= 0 && item->value != last + 1) {
+        gaps += (uint32_t)(item->value - last - 1);
+        PRINTF("[AUDIT] Sequência %" PRId32 " -> %" PRId32 " (%" PRIu32 " faltando no total).\n",
+               last, item->value, gaps);
+    }
+    last = item->value;
+}
+
+/* ==========================
+ *  Monitor – mudanças no status publicado pelo supervisor
+ * ========================== */
+static void on_status(const bus_msg_t *msg) {
+    static bus_status_t prev = { .shed_level = SHED_NORMAL };
+    bus_status_t st;
+    memcpy(&st, msg->payload, sizeof(st));
+    if (st.shed_level != prev.shed_level || st.restarts != prev.restarts) {
+        PRINTF("[MON] Status: heap=%" PRIu32 " B, degradação=%s, recriações=%" PRIu32 "\n",
+               st.free_heap, shed_level_name((shed_level_t)st.shed_level), st.restarts);
+    }
+    prev = st;
+}
+
+bool bus_subs_start(void) {
+    return spawn(BUS_TOPIC_RECORD, "bus_agg", on_record_aggregate) &&
+           spawn(BUS_TOPIC_RECORD, "bus_audit", on_record_audit) &&
+           spawn(BUS_TOPIC_STATUS, "bus_mon", on_status);
+}
+
+#endif // APP_BUS
@@ -0,0 +1,268 @@
+#pragma once
+
+/* ==========================
+ *  Channel<T, N> – canal tipado sobre primitivas FreeRTOS
+ *
+ *  - Armazenamento estático dimensionado em tempo de compilação (nada de heap).
+ *  - Só aceita payloads trivialmente copiáveis (são copiados byte a byte).
+ *  - Backend escolhido em tempo de compilação; a interface é a mesma para
+ *    todos, então trocar de backend não muda os pontos de chamada.
+ *  - Tudo inline: com o backend de fila, send/receive viram exatamente uma
+ *    chamada xQueueSend/xQueueReceive.
+ *
+ *  Semântica de lote: só o primeiro item pode bloquear (até `wait`); os
+ *  demais são transferidos sem bloquear. Retorna quantos itens passaram.
+ * ========================== */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#include "app_config.h"
+
+#if APP_HAS_RINGBUF
+#include "freertos/ringbuf.h"
+#endif
+
+namespace chan {
+
+/* Seletores de backend */
+struct QueueBackend {};    // xQueueCreateStatic – MPMC, bloqueante nos dois lados
+struct SpscBackend {};     // anel lock-free – 1 produtor / 1 consumidor
+struct RingbufBackend {};  // esp_ringbuf NOSPLIT – itens de tamanho fixo
+
+#if APP_CHANNEL_BACKEND == 2 && !APP_HAS_RINGBUF
+#error "APP_CHANNEL_BACKEND=2 (esp_ringbuf) indisponível neste target"
+#endif
+
+using DefaultBackend =
+    std::conditional_t<APP_CHANNEL_BACKEND == 1, SpscBackend,
+    std::conditional_t<APP_CHANNEL_BACKEND == 2, RingbufBackend, QueueBackend>>;
+
+namespace detail {
+
+template <typename T, size_t N, typename Backend>
+class Impl;
+
+/* --- Fila FreeRTOS (estática) --- */
+template <typename T, size_t N>
+class Impl<T, N, QueueBackend> {
+public:
+    bool init() {
+        q_ = xQueueCreateStatic(N, sizeof(T), storage_, &ctrl_);
+        return q_ != nullptr;
+    }
+    bool send(const T &v, TickType_t wait) { return xQueueSend(q_, &v, wait) == pdTRUE; }
+    bool receive(T &out, TickType_t wait) { return xQueueReceive(q_, &out, wait) == pdTRUE; }
+    size_t size() const { return uxQueueMessagesWaiting(q_); }
+    void reset() { xQueueReset(q_); }
+    void detach_receiver() {}
+    QueueHandle_t native_handle() const { return q_; }
+
+private:
+    QueueHandle_t q_ = nullptr;
+    StaticQueue_t ctrl_;
+    uint8_t storage_[N * sizeof(T)];
+};
+
+/* --- Anel SPSC lock-free ---
+ * Índices head/tail em [0, 2N) com acquire/release; funciona entre núcleos
+ * e com qualquer N (módulo 2N distingue cheio de vazio sem depender do
+ * estouro de uint32). Receptor bloqueia via notificação de tarefa; emissor
+ * com anel cheio faz polling a cada tick até `wait` (produtor nunca deveria
+ * bloquear por muito tempo nesta pipeline).
+ *
+ * Handshake do receptor: emissor publica head e depois lê waiter; receptor
+ * publica waiter e depois relê head. Store→load em variáveis distintas só
+ * fica ordenado com fence seq_cst dos dois lados; sem ela os dois podem ler
+ * o valor antigo e o receptor dorme com item no anel. */
+template <typename T, size_t N>
+class Impl<T, N, SpscBackend> {
+public:
+    bool init() {
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        waiter_.store(nullptr, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool send(const T &v, TickType_t wait) {
+        TickType_t start = xTaskGetTickCount();
+        while (!try_push(v)) {
+            if (wait == 0 || (wait != portMAX_DELAY && xTaskGetTickCount() - start >= wait)) {
+                return false;
+            }
+            vTaskDelay(1);
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        TaskHandle_t w = waiter_.exchange(nullptr, std::memory_order_acq_rel);
+        if (w) {
+            xTaskNotifyGive(w);
+        }
+        return true;
+    }
+
+    bool receive(T &out, TickType_t wait) {
+        if (try_pop(out)) {
+            return true;
+        }
+        TickType_t start = xTaskGetTickCount();
+        while (wait != 0) {
+            waiter_.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (try_pop(out)) {
+                waiter_.store(nullptr, std::memory_order_relaxed);
+                return true;
+            }
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            if (wait != portMAX_DELAY && elapsed >= wait) {
+                break;
+            }
+            ulTaskNotifyTake(pdTRUE, wait == portMAX_DELAY ? portMAX_DELAY : wait - elapsed);
+        }
+        waiter_.store(nullptr, std::memory_order_relaxed);
+        return try_pop(out);
+    }
+
+    size_t size() const {
+        return distance(head_.load(std::memory_order_acquire), tail_.load(std::memory_order_acquire));
+    }
+
+    /* Só é seguro com produtor e consumidor parados (mesma regra do xQueueReset). */
+    void reset() { tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+    /* Chamar antes de apagar uma tarefa receptora que possa estar bloqueada,
+     * para o produtor não notificar um TCB já liberado. */
+    void detach_receiver() { waiter_.store(nullptr, std::memory_order_release); }
+
+private:
+    static constexpr uint32_t kWrap = 2 * N;
+
+    static uint32_t next(uint32_t i) { return i + 1 == kWrap ? 0 : i + 1; }
+    static uint32_t slot(uint32_t i) { return i < N ? i : i - N; }
+    static uint32_t distance(uint32_t h, uint32_t t) { return h >= t ? h - t : h + kWrap - t; }
+
+    bool try_push(const T &v) {
+        uint32_t h = head_.load(std::memory_order_relaxed);
+        if (distance(h, tail_.load(std::memory_order_acquire)) >= N) {
+            return false;
+        }
+        std::memcpy(&slots_[slot(h)], &v, sizeof(T));
+        head_.store(next(h), std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T &out) {
+        uint32_t t = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) == t) {
+            return false;
+        }
+        std::memcpy(&out, &slots_[slot(t)], sizeof(T));
+        tail_.store(next(t), std::memory_order_release);
+        return true;
+    }
+
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<TaskHandle_t> waiter_{nullptr};
+    T slots_[N];
+};
+
+#if APP_HAS_RINGBUF
+/* --- esp_ringbuf NOSPLIT (estático) ---
+ * Cada item ocupa o payload alinhado a 4 bytes + 8 bytes de cabeçalho. */
+template <typename T, size_t N>
+class Impl<T, N, RingbufBackend> {
+public:
+    bool init() {
+        rb_ = xRingbufferCreateStatic(sizeof(storage_), RINGBUF_TYPE_NOSPLIT, storage_, &ctrl_);
+        return rb_ != nullptr;
+    }
+    bool send(const T &v, TickType_t wait) { return xRingbufferSend(rb_, &v, sizeof(T), wait) == pdTRUE; }
+    bool receive(T &out, TickType_t wait) {
+        size_t len = 0;
+        void *p = xRingbufferReceive(rb_, &len, wait);
+        if (!p) {
+            return false;
+        }
+        std::memcpy(&out, p, sizeof(T));
+        vRingbufferReturnItem(rb_, p);
+        return true;
+    }
+    size_t size() const {
+        UBaseType_t waiting = 0;
+        vRingbufferGetInfo(rb_, nullptr, nullptr, nullptr, nullptr, &waiting);
+        return waiting;
+    }
+    void reset() {
+        T tmp;
+        while (receive(tmp, 0)) {
+        }
+    }
+    void detach_receiver() {}
+
+private:
+    static constexpr size_t kItemBytes = ((sizeof(T) + 3u) & ~size_t(3u)) + 8u;
+
+    RingbufHandle_t rb_ = nullptr;
+    StaticRingbuffer_t ctrl_;
+    alignas(4) uint8_t storage_[N * kItemBytes];
+};
+
+#endif // APP_HAS_RINGBUF
+
+} // namespace detail
+
+template <typename T, size_t N, typename Backend = DefaultBackend>
+class Channel {
+    static_assert(std::is_trivially_copyable_v<T>, "Channel<T>: payload precisa ser trivialmente copiável");
+    static_assert(N > 0, "Channel<T, N>: capacidade precisa ser > 0");
+
+public:
+    using value_type = T;
+    using backend_type = Backend;
+    static constexpr size_t capacity = N;
+
+    /* Cria as estruturas do kernel sobre o armazenamento estático. */
+    bool init() { return impl_.init(); }
+
+    bool send(const T &v, TickType_t wait = 0) { return impl_.send(v, wait); }
+    bool receive(T &out, TickType_t wait = portMAX_DELAY) { return impl_.receive(out, wait); }
+
+    size_t send_batch(const T *items, size_t n, TickType_t wait = 0) {
+        size_t i = 0;
+        if (n && impl_.send(items[0], wait)) {
+            for (i = 1; i < n && impl_.send(items[i], 0); ++i) {
+            }
+        }
+        return i;
+    }
+
+    size_t receive_batch(T *out, size_t max, TickType_t wait = portMAX_DELAY) {
+        size_t i = 0;
+        if (max && impl_.receive(out[0], wait)) {
+            for (i = 1; i < max && impl_.receive(out[i], 0); ++i) {
+            }
+        }
+        return i;
+    }
+
+    size_t size() const { return impl_.size(); }
+    void reset() { impl_.reset(); }
+    void detach_receiver() { impl_.detach_receiver(); }
+
+    /* Handle nativo – só existe com o backend de fila (p.ex. para queue sets). */
+    template <typename B = Backend, typename = std::enable_if_t<std::is_same_v<B, QueueBackend>>>
+    QueueHandle_t native_handle() const { return impl_.native_handle(); }
+
+private:
+    detail::Impl<T, N, Backend> impl_;
+};
+
+} // namespace chan
@@ -0,0 +1,108 @@
+#pragma once
+
+/* ==========================
+ *  Corrotinas sem pilha (estilo protothreads)
+ *  Cada corrotina é uma função coro_status_t f(coro_t *c, void *ctx)
+ *  retomada a partir do último ponto de espera (switch em __LINE__).
+ *  Regras: variáveis locais NÃO sobrevivem a um ponto de espera (estado
+ *  vai no ctx); não usar switch próprio entre CORO_BEGIN e CORO_END; um
+ *  ponto de espera por linha.
+ *
+ *  coro_run_once executa uma rodada em todas as corrotinas; o chamador
+ *  dorme até coro_next_wake_us quando nenhuma avançou.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CORO_READY = 0,   // cedeu a vez, quer rodar de novo
+    CORO_WAITING,     // condição falsa; com prazo em wake_us se has_wake
+    CORO_DONE,
+} coro_status_t;
+
+typedef struct {
+    uint16_t lc;          // ponto de retomada (0 = início)
+    uint16_t passes;      // esperas concluídas (detecta avanço no mesmo ponto)
+    bool has_wake;        // wake_us válido
+    int64_t wake_us;      // prazo da espera atual (esp_timer)
+} coro_t;
+
+typedef coro_status_t (*coro_fn_t)(coro_t *c, void *ctx);
+
+typedef struct {
+    coro_fn_t fn;
+    void *ctx;
+    coro_t c;
+    coro_status_t last;
+} coro_slot_t;
+
+#define CORO_BEGIN(c)        switch ((c)->lc) { case 0:
+#define CORO_END(c)          } (c)->lc = 0; return CORO_DONE
+
+#define CORO_YIELD(c)                                                        \
+    do { (c)->lc = __LINE__; (c)->has_wake = false; return CORO_READY;       \
+         case __LINE__:; } while (0)
+
+/* Espera `cond` sem prazo */
+#define CORO_AWAIT(c, cond)                                                  \
+    do { (c)->lc = __LINE__; (c)->has_wake = false;                          \
+         case __LINE__: if (!(cond)) return CORO_WAITING;                    \
+         (c)->passes++; } while (0)
+
+/* Espera `cond` até o instante t_us; `ok` recebe o resultado */
+#define CORO_AWAIT_UNTIL(c, cond, t_us, ok)                                  \
+    do { (c)->lc = __LINE__; (c)->has_wake = true; (c)->wake_us = (t_us);    \
+         case __LINE__:                                                      \
+         if (((ok) = (cond)) == false) {                                     \
+             if (esp_timer_get_time() < (c)->wake_us) return CORO_WAITING;   \
+         }                                                                   \
+         (c)->has_wake = false; (c)->passes++; } while (0)
+
+/* Dorme até o instante t_us (esp_timer) */
+#define CORO_SLEEP_UNTIL(c, t_us)                                            \
+    do { (c)->lc = __LINE__; (c)->has_wake = true; (c)->wake_us = (t_us);    \
+         case __LINE__:                                                      \
+         if (esp_timer_get_time() < (c)->wake_us) return CORO_WAITING;       \
+         (c)->has_wake = false; (c)->passes++; } while (0)
+
+#define CORO_SLEEP_MS(c, ms)  CORO_SLEEP_UNTIL(c, esp_timer_get_time() + (int64_t)(ms) * 1000)
+
+/* Uma rodada; retorna true se alguma corrotina avançou (concluiu uma
+ * espera, cedeu a vez ou terminou) – nesse caso vale rodar de novo já. */
+static inline bool coro_run_once(coro_slot_t *slots, int n) {
+    bool progress = false;
+    for (int i = 0; i < n; i++) {
+        coro_slot_t *s = &slots[i];
+        if (s->last == CORO_DONE) {
+            continue;
+        }
+        uint16_t passes = s->c.passes;
+        s->last = s->fn(&s->c, s->ctx);
+        if (s->last != CORO_WAITING || s->c.passes != passes) {
+            progress = true;
+        }
+    }
+    return progress;
+}
+
+/* Menor prazo entre as corrotinas em espera; INT64_MAX se nenhuma tem */
+static inline int64_t coro_next_wake_us(const coro_slot_t *slots, int n) {
+    int64_t w = INT64_MAX;
+    for (int i = 0; i < n; i++) {
+        if (slots[i].last == CORO_WAITING && slots[i].c.has_wake && slots[i].c.wake_us < w) {
+            w = slots[i].c.wake_us;
+        }
+    }
+    return w;
+}
+
+#ifdef __cplusplus
+}
+#endif
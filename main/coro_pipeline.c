@@ -0,0 +1,255 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "metrics.h"
+#include "traffic.h"
+#include "rx_rto.h"
+#include "coro.h"
+#include "coro_pipeline.h"
+
+#if APP_MODE_COROUTINE
+
+/* ==========================
+ *  PARÂMETROS DO MODO
+ * ========================== */
+#define CORO_BENCH_ITEMS       2000
+#define CORO_STACK_WORDS       4096
+#define CORO_TASK_PRIO         RX_TASK_PRIO
+#define CORO_TICK_US           (1000000 / configTICK_RATE_HZ)
+
+/* Estado que precisa sobreviver aos pontos de espera */
+typedef struct {
+    traffic_t traffic;
+    pipe_item_t item;
+    int32_t value;
+    uint32_t remaining;     // comparação: itens a produzir
+} gen_ctx_t;
+
+typedef struct {
+    pipe_item_t item;
+    rx_rto_t rto;
+    int timeouts;
+    bool got;
+    uint32_t remaining;     // comparação: itens a consumir
+} rx_ctx_t;
+
+static gen_ctx_t s_gen;
+static rx_ctx_t s_rx;
+
+/* "Processamento" da RX: mesmo malloc/cópia/free da pipeline normal */
+static bool rx_process(const pipe_item_t *item, bool print) {
+    int *tmp = (int*) malloc(sizeof(int));
+    if (!tmp) {
+        return false;
+    }
+    *tmp = item->value;
+    if (print) {
+        PRINTF("[RX] Transmitindo valor: %d\n", *tmp);
+    }
+    free(tmp);
+    return true;
+}
+
+/* ==========================
+ *  Comparação: modelo tarefa por estágio
+ * ========================== */
+static TaskHandle_t s_ctrl = NULL;
+
+static void bench_task_gen(void *pv) {
+    pipe_item_t item = { 0 };
+    for (uint32_t i = 0; i < CORO_BENCH_ITEMS; i++) {
+        item.value = (int32_t)i;
+        pipe_send(&item, portMAX_DELAY);
+    }
+    vTaskDelete(NULL);
+}
+
+static void bench_task_rx(void *pv) {
+    pipe_item_t item;
+    for (uint32_t i = 0; i < CORO_BENCH_ITEMS; i++) {
+        pipe_receive(&item, portMAX_DELAY);
+        rx_process(&item, false);
+    }
+    xTaskNotifyGive(s_ctrl);
+    vTaskDelete(NULL);
+}
+
+static int64_t bench_tasks_us(void) {
+    pipe_reset();
+    s_ctrl = xTaskGetCurrentTaskHandle();
+    int64_t t0 = esp_timer_get_time();
+    xTaskCreatePinnedToCore(bench_task_rx, "bench_rx", RX_STACK_WORDS, NULL,
+                            RX_TASK_PRIO, NULL, APP_PIPE_CORE);
+    xTaskCreatePinnedToCore(bench_task_gen, "bench_gen", GEN_STACK_WORDS, NULL,
+                            GEN_TASK_PRIO, NULL, APP_PIPE_CORE);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return esp_timer_get_time() - t0;
+}
+
+/* ==========================
+ *  Comparação: corrotinas
+ * ========================== */
+static coro_status_t bench_coro_gen(coro_t *c, void *pv) {
+    gen_ctx_t *g = pv;
+    CORO_BEGIN(c);
+    while (g->remaining) {
+        g->item.value = g->value;
+        CORO_AWAIT(c, pipe_send(&g->item, 0));
+        g->value++;
+        g->remaining--;
+    }
+    CORO_END(c);
+}
+
+static coro_status_t bench_coro_rx(coro_t *c, void *pv) {
+    rx_ctx_t *r = pv;
+    CORO_BEGIN(c);
+    while (r->remaining) {
+        CORO_AWAIT(c, pipe_receive(&r->item, 0));
+        rx_process(&r->item, false);
+        r->remaining--;
+    }
+    CORO_END(c);
+}
+
+static int64_t bench_coro_us(void) {
+    pipe_reset();
+    s_gen.value = 0;
+    s_gen.remaining = CORO_BENCH_ITEMS;
+    s_rx.remaining = CORO_BENCH_ITEMS;
+    coro_slot_t slots[] = {
+        { .fn = bench_coro_gen, .ctx = &s_gen },
+        { .fn = bench_coro_rx,  .ctx = &s_rx },
+    };
+    int64_t t0 = esp_timer_get_time();
+    while (coro_run_once(slots, 2)) {
+    }
+    return esp_timer_get_time() - t0;
+}
+
+static void bench_report(void) {
+    int64_t t_tasks = bench_tasks_us();
+    int64_t t_coro = bench_coro_us();
+
+    uint32_t cyc_tasks = (uint32_t)(t_tasks * APP_CPU_FREQ_MHZ / CORO_BENCH_ITEMS);
+    uint32_t cyc_coro = (uint32_t)(t_coro * APP_CPU_FREQ_MHZ / CORO_BENCH_ITEMS);
+    uint32_t ram_tasks = GEN_STACK_WORDS + RX_STACK_WORDS + LOG_STACK_WORDS + 3 * sizeof(StaticTask_t);
+    uint32_t ram_coro = CORO_STACK_WORDS + sizeof(StaticTask_t) + sizeof(s_gen) + sizeof(s_rx)
+                      + 3 * sizeof(coro_slot_t);
+
+    PRINTF("[CORO] Comparação com %u itens GERADOR→RX:\n", (unsigned)CORO_BENCH_ITEMS);
+    PRINTF("[CORO] %-16s %12s %14s\n", "modelo", "ciclos/item", "RAM pilha+TCB");
+    PRINTF("[CORO] %-16s %12" PRIu32 " %12" PRIu32 " B\n", "tarefa/estágio", cyc_tasks, ram_tasks);
+    PRINTF("[CORO] %-16s %12" PRIu32 " %12" PRIu32 " B\n", "corrotinas", cyc_coro, ram_coro);
+}
+
+/* ==========================
+ *  Pipeline ao vivo
+ * ========================== */
+static coro_status_t coro_generator(coro_t *c, void *pv) {
+    gen_ctx_t *g = pv;
+    CORO_BEGIN(c);
+    for (;;) {
+        g->item.value = g->value;
+        g->item.t_enq_us = metrics_now_us();
+        if (pipe_send(&g->item, 0)) {
+            g_metrics.produced++;
+            PRINTF("[GERADOR] Valor %d enfileirado com sucesso.\n", (int)g->value);
+        } else {
+            g_metrics.dropped++;
+            PRINTF("[GERADOR] Fila cheia – valor %d descartado.\n", (int)g->value);
+        }
+        g->value++;
+        CORO_SLEEP_UNTIL(c, traffic_advance(&g->traffic));
+    }
+    CORO_END(c);
+}
+
+static coro_status_t coro_receiver(coro_t *c, void *pv) {
+    rx_ctx_t *r = pv;
+    CORO_BEGIN(c);
+    for (;;) {
+        CORO_AWAIT_UNTIL(c, pipe_receive(&r->item, 0),
+                         esp_timer_get_time() + r->rto.rto_us, r->got);
+        if (r->got) {
+            r->timeouts = 0;
+            rx_rto_on_arrival(&r->rto, metrics_now_us());
+            if (rx_process(&r->item, true)) {
+                metrics_on_consumed(&r->item);
+            } else {
+                PRINTF("[RX] ERRO CRÍTICO: malloc falhou – sem memória.\n");
+            }
+        } else {
+            r->timeouts++;
+            rx_rto_on_timeout(&r->rto);
+            PRINTF("[RX] Timeout de %u ms na fila (contagem=%d).\n",
+                   (unsigned)rx_rto_ms(&r->rto), r->timeouts);
+            if (r->timeouts == RX_RECOVER_RESET_Q) {
+                pipe_recover_t rec;
+                pipe_recover(&rec);
+                PRINTF("[RX] Recuperação moderada: fila reiniciada (%u itens preservados, %u perdidos).\n",
+                       (unsigned)rec.reinjected, (unsigned)rec.lost);
+            }
+        }
+        CORO_SLEEP_MS(c, RX_PROC_DELAY_MS);
+    }
+    CORO_END(c);
+}
+
+static coro_status_t coro_logger(coro_t *c, void *pv) {
+    CORO_BEGIN(c);
+    for (;;) {
+        PRINTF("[LOG] produzidos=%" PRIu32 " consumidos=%" PRIu32 " descartes=%" PRIu32
+               " | pilha livre=%u\n",
+               g_metrics.produced, g_metrics.consumed, g_metrics.dropped,
+               (unsigned)uxTaskGetStackHighWaterMark(NULL));
+        CORO_SLEEP_MS(c, LOG_PERIOD_MS);
+    }
+    CORO_END(c);
+}
+
+static void task_coro(void *pv) {
+    bench_report();
+
+    pipe_reset();
+    traffic_cfg_t cfg;
+    traffic_default_cfg(&cfg);
+    traffic_init(&s_gen.traffic, &cfg);
+    s_gen.value = 0;
+    rx_rto_init(&s_rx.rto);
+    s_rx.timeouts = 0;
+
+    coro_slot_t slots[] = {
+        { .fn = coro_generator, .ctx = &s_gen },
+        { .fn = coro_receiver,  .ctx = &s_rx },
+        { .fn = coro_logger,    .ctx = NULL },
+    };
+    const int n = sizeof(slots) / sizeof(slots[0]);
+
+    PRINTF("[CORO] Pipeline em corrotinas iniciada.\n");
+    for (;;) {
+        while (coro_run_once(slots, n)) {
+        }
+        /* Ninguém pode avançar: dorme até o prazo mais próximo */
+        int64_t wake = coro_next_wake_us(slots, n);
+        int64_t wait_us = wake == INT64_MAX ? CORO_TICK_US : wake - esp_timer_get_time();
+        TickType_t ticks = wait_us > 0 ? (TickType_t)((wait_us + CORO_TICK_US - 1) / CORO_TICK_US) : 1;
+        vTaskDelay(ticks);
+    }
+}
+
+void coro_pipeline_start(void) {
+    xTaskCreatePinnedToCore(task_coro, "task_coro", CORO_STACK_WORDS, NULL,
+                            CORO_TASK_PRIO, NULL, APP_PIPE_CORE);
+}
+
+#endif // APP_MODE_COROUTINE
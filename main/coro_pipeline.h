@@ -0,0 +1,23 @@
+#pragma once
+
+/* ==========================
+ *  Modo corrotinas (APP_MODE_COROUTINE)
+ *  GERADOR, RX e LOG como corrotinas sem pilha (coro.h) numa única
+ *  tarefa: pontos de espera para recepção da fila e atrasos, sem troca de
+ *  contexto entre estágios.
+ *
+ *  Antes da pipeline ao vivo roda uma comparação com o modelo tarefa por
+ *  estágio: mesmos CORO_BENCH_ITEMS itens GERADOR→RX sem ritmo nem print,
+ *  ciclos por item em cada modelo, e a RAM de pilhas + TCBs de cada um.
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria a tarefa das corrotinas (comparação + pipeline ao vivo). */
+void coro_pipeline_start(void);
+
+#ifdef __cplusplus
+}
+#endif
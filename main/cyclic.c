@@ -0,0 +1,206 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "metrics.h"
+#include "cyclic.h"
+
+#if APP_MODE_CYCLIC
+
+#if !CONFIG_IDF_TARGET_LINUX
+#include "driver/gptimer.h"
+#include "esp_attr.h"
+#endif
+
+/* ==========================
+ *  PARÂMETROS DO EXECUTIVO
+ * ========================== */
+#define CYC_MINOR_US           10000                          // quadro menor
+#define CYC_MINOR_PER_MAJOR    (GEN_PERIOD_MS * 1000 / CYC_MINOR_US)   // quadro maior = período da fonte
+#define CYC_MAX_STEPS          3
+#define CYC_REPORT_MS          10000                          // relatório (tarefa de baixa prioridade)
+#define CYC_TASK_PRIO          (configMAX_PRIORITIES - 2)
+#define CYC_STACK_WORDS        4096
+#define CYC_REPORT_PRIO        (tskIDLE_PRIORITY + 1)
+#define CYC_REPORT_STACK_WORDS 3072
+
+#if GEN_PERIOD_MS * 1000 % CYC_MINOR_US != 0
+#error "GEN_PERIOD_MS precisa ser múltiplo do quadro menor"
+#endif
+
+typedef void (*cyc_step_t)(void);
+
+typedef struct {
+    cyc_step_t steps[CYC_MAX_STEPS];   // executados em ordem; NULL termina
+} cyc_frame_t;
+
+/* Estado entre passos (só a tarefa do executivo acessa) */
+static int32_t s_value = 0;
+static pipe_item_t s_item;
+static bool s_have_item = false;
+
+static TaskHandle_t s_exec = NULL;
+
+/* Contadores do executivo; impressos só pela tarefa de relatório, para
+ * que o printf não alongue o quadro que está sendo medido */
+static volatile uint32_t s_frames = 0;
+static volatile uint32_t s_overruns = 0;        // quadros que passaram do próprio fim
+static volatile uint32_t s_lost = 0;            // quadros pulados por estouro
+static volatile int32_t  s_last_overrun = -1;   // índice na tabela do último estouro
+static volatile int32_t  s_last_tx = -1;        // último valor transmitido
+
+/* ==========================
+ *  Passos
+ * ========================== */
+static void step_source(void) {
+    pipe_item_t item = { .value = s_value, .t_enq_us = metrics_now_us() };
+    if (pipe_send(&item, 0)) {
+        g_metrics.produced++;
+    } else {
+        g_metrics.dropped++;
+    }
+    s_value++;
+}
+
+static void step_process(void) {
+    if (s_have_item || !pipe_receive(&s_item, 0)) {
+        return;
+    }
+    int *tmp = (int*) malloc(sizeof(int));
+    if (!tmp) {
+        PRINTF("[CYCLIC] ERRO: malloc falhou – item %d descartado.\n", (int)s_item.value);
+        return;
+    }
+    *tmp = s_item.value;
+    s_item.value = *tmp;
+    free(tmp);
+    s_have_item = true;
+}
+
+static void step_transmit(void) {
+    if (!s_have_item) {
+        return;
+    }
+    s_last_tx = s_item.value;
+    metrics_on_consumed(&s_item);
+    s_have_item = false;
+}
+
+/* Tabela estática: fonte no quadro 0, reprocessamento a cada terço do
+ * quadro maior para absorver itens atrasados; o resto fica livre */
+static const cyc_frame_t k_schedule[CYC_MINOR_PER_MAJOR] = {
+    [0]                           = { { step_source, step_process, step_transmit } },
+    [CYC_MINOR_PER_MAJOR / 3]     = { { step_process, step_transmit } },
+    [2 * CYC_MINOR_PER_MAJOR / 3] = { { step_process, step_transmit } },
+};
+
+/* ==========================
+ *  Base de tempo
+ * ========================== */
+#if CONFIG_IDF_TARGET_LINUX
+static void cyc_tick(void *arg) {
+    xTaskNotifyGive(s_exec);
+}
+
+static bool cyc_timer_start(void) {
+    const esp_timer_create_args_t args = { .callback = cyc_tick, .name = "cyclic" };
+    esp_timer_handle_t t;
+    return esp_timer_create(&args, &t) == ESP_OK &&
+           esp_timer_start_periodic(t, CYC_MINOR_US) == ESP_OK;
+}
+#else
+static bool IRAM_ATTR cyc_on_alarm(gptimer_handle_t timer, const gptimer_alarm_event_data_t *edata, void *ctx) {
+    BaseType_t hp = pdFALSE;
+    vTaskNotifyGiveFromISR(s_exec, &hp);
+    return hp == pdTRUE;
+}
+
+static bool cyc_timer_start(void) {
+    gptimer_handle_t timer = NULL;
+    const gptimer_config_t cfg = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = 1000000,
+    };
+    const gptimer_alarm_config_t alarm = {
+        .alarm_count = CYC_MINOR_US,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    const gptimer_event_callbacks_t cbs = { .on_alarm = cyc_on_alarm };
+    return gptimer_new_timer(&cfg, &timer) == ESP_OK &&
+           gptimer_register_event_callbacks(timer, &cbs, NULL) == ESP_OK &&
+           gptimer_set_alarm_action(timer, &alarm) == ESP_OK &&
+           gptimer_enable(timer) == ESP_OK &&
+           gptimer_start(timer) == ESP_OK;
+}
+#endif
+
+/* ==========================
+ *  Executivo
+ * ========================== */
+static void task_cyclic(void *pv) {
+    if (!cyc_timer_start()) {
+        PRINTF("[CYCLIC] ERRO: falha ao armar o timer.\n");
+        vTaskDelete(NULL);
+    }
+
+    /* Referência: primeiro disparo = quadro 0; os seguintes são múltiplos */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    uint32_t t0 = metrics_now_us();
+    uint32_t frame = 0;       // quadros desde t0 (inclui os perdidos)
+
+    for (;;) {
+        uint32_t start = metrics_now_us();
+        metrics_on_release(t0 + frame * CYC_MINOR_US, start);
+
+        const cyc_frame_t *f = &k_schedule[frame % CYC_MINOR_PER_MAJOR];
+        for (int i = 0; i < CYC_MAX_STEPS && f->steps[i]; i++) {
+            f->steps[i]();
+        }
+
+        /* Estouro = passos terminaram depois do fim do próprio quadro, mesmo
+         * que só um disparo tenha acumulado (o próximo quadro só sai atrasado) */
+        if ((int32_t)(metrics_now_us() - (t0 + (frame + 1) * CYC_MINOR_US)) >= 0) {
+            s_overruns++;
+            s_last_overrun = (int32_t)(frame % CYC_MINOR_PER_MAJOR);
+        }
+
+        /* Mais de um disparo acumulado = quadros inteiros perdidos, pulados
+         * (a tabela segue o relógio) */
+        uint32_t fired = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        s_lost += fired - 1;
+        frame += fired;
+        s_frames = frame;
+    }
+}
+
+/* Relatório fora do executivo (prioridade baixa: só roda nas folgas) */
+static void task_cyclic_report(void *pv) {
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(CYC_REPORT_MS));
+        PRINTF("[CYCLIC] quadros=%" PRIu32 " estouros=%" PRIu32 " (último no quadro %" PRId32 ")"
+               " perdidos=%" PRIu32 " consumidos=%" PRIu32 " | último transmitido=%" PRId32 "\n",
+               s_frames, s_overruns, s_last_overrun, s_lost, g_metrics.consumed, s_last_tx);
+        metrics_print_timing("[CYCLIC]");
+    }
+}
+
+void cyclic_start(void) {
+    PRINTF("[CYCLIC] Quadro menor %u us, quadro maior %u quadros.\n",
+           (unsigned)CYC_MINOR_US, (unsigned)CYC_MINOR_PER_MAJOR);
+    xTaskCreatePinnedToCore(task_cyclic, "task_cyclic", CYC_STACK_WORDS, NULL,
+                            CYC_TASK_PRIO, &s_exec, APP_PIPE_CORE);
+    xTaskCreatePinnedToCore(task_cyclic_report, "task_cyc_report", CYC_REPORT_STACK_WORDS, NULL,
+                            CYC_REPORT_PRIO, NULL, APP_PIPE_CORE);
+}
+
+#endif // APP_MODE_CYCLIC
@@ -0,0 +1,25 @@
+#pragma once
+
+/* ==========================
+ *  Executivo cíclico dirigido por tempo (APP_MODE_CYCLIC)
+ *  Sem preempção entre estágios: um timer de hardware (gptimer; esp_timer
+ *  no target linux) marca cada quadro menor de CYC_MINOR_US, e uma única
+ *  tarefa executa os passos FONTE / PROCESSAMENTO / TRANSMISSÃO previstos
+ *  para aquele quadro na tabela estática (quadro maior = CYC_MINOR_PER_MAJOR
+ *  quadros menores).
+ *
+ *  Detecta estouro de quadro (passos que não couberam antes do próximo
+ *  disparo) e mede jitter de liberação e latência com as mesmas métricas
+ *  da pipeline preemptiva (metrics_print_timing), para comparação direta.
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria a tarefa do executivo e arma o timer. */
+void cyclic_start(void);
+
+#ifdef __cplusplus
+}
+#endif
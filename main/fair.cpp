@@ -0,0 +1,109 @@
+#include "fair.h"
+#include "channel.hpp"
+
+#include "freertos/queue.h"
+
+#if APP_MODE_FAIR
+
+/* Filas FreeRTOS (o queue set precisa do handle nativo) */
+static chan::Channel<pipe_item_t, FAIR_QUEUE_LEN, chan::QueueBackend> s_q[FAIR_STREAMS];
+static QueueSetHandle_t s_set = nullptr;
+
+static const int32_t k_weight[FAIR_STREAMS] = FAIR_WEIGHTS;
+
+/* Estado do DRR (só a RX acessa) */
+static int32_t s_deficit[FAIR_STREAMS];
+static int s_cur = 0;
+static bool s_in_visit = false;
+
+/* Cada item enviado deixa um evento no set. Itens são lidos direto da
+ * fila escolhida pelo DRR, não da que o set apontou; para o set não
+ * acumular eventos, cada item lido consome um evento: um já retirado
+ * pela espera bloqueante (s_events) ou um retirado agora sem esperar. */
+static uint32_t s_events = 0;
+
+fair_stats_t g_fair_stats[FAIR_STREAMS];
+
+static void next_stream()
+{
+    s_in_visit = false;
+    s_cur = (s_cur + 1) % FAIR_STREAMS;
+}
+
+static void consume_event()
+{
+    if (s_events > 0) {
+        s_events--;
+    } else {
+        xQueueSelectFromSet(s_set, 0);
+    }
+}
+
+extern "C" {
+
+bool fair_init(void)
+{
+    s_set = xQueueCreateSet(FAIR_STREAMS * FAIR_QUEUE_LEN);
+    if (!s_set) {
+        return false;
+    }
+    for (auto &q : s_q) {
+        if (!q.init() || xQueueAddToSet(q.native_handle(), s_set) != pdPASS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool fair_send(const pipe_item_t *item, TickType_t wait)
+{
+    fair_stats_t &st = g_fair_stats[item->key];
+    if (s_q[item->key].send(*item, wait)) {
+        st.sent = st.sent + 1;
+        return true;
+    }
+    st.dropped = st.dropped + 1;
+    return false;
+}
+
+bool fair_receive(pipe_item_t *out, TickType_t wait)
+{
+    for (;;) {
+        /* Duas voltas: na primeira um fluxo pode estar sem crédito */
+        for (int i = 0; i < 2 * FAIR_STREAMS; i++) {
+            auto &q = s_q[s_cur];
+            if (!s_in_visit) {
+                s_deficit[s_cur] += k_weight[s_cur];
+                s_in_visit = true;
+            }
+            if (s_deficit[s_cur] >= 1 && q.receive(*out, 0)) {
+                consume_event();
+                s_deficit[s_cur]--;
+                g_fair_stats[s_cur].served = g_fair_stats[s_cur].served + 1;
+                if (q.size() == 0) {
+                    s_deficit[s_cur] = 0;   // fila vazia não acumula crédito
+                    next_stream();
+                } else if (s_deficit[s_cur] < 1) {
+                    next_stream();
+                }
+                return true;
+            }
+            if (q.size() == 0) {
+                s_deficit[s_cur] = 0;
+            }
+            next_stream();
+        }
+
+        /* Todas vazias: uma espera só para todas as filas */
+        if (xQueueSelectFromSet(s_set, wait) == nullptr) {
+            return false;
+        }
+        s_events++;
+    }
+}
+
+size_t fair_waiting(int stream) { return s_q[stream].size(); }
+
+} // extern "C"
+
+#endif // APP_MODE_FAIR
@@ -0,0 +1,47 @@
+#pragma once
+
+/* ==========================
+ *  Filas por fluxo com escalonamento justo (APP_MODE_FAIR)
+ *  Cada fluxo (item.key = 0..FAIR_STREAMS-1) tem sua própria fila; a RX
+ *  as serve por Deficit Round Robin: a cada visita o fluxo ganha
+ *  FAIR_WEIGHTS[i] de crédito e envia enquanto tiver crédito e itens.
+ *  Um fluxo tagarela só enche a própria fila; os demais esperam no
+ *  máximo uma rodada.
+ *
+ *  As filas são membros de um queue set: a RX dorme numa única espera
+ *  (xQueueSelectFromSet) que cobre todas. Um consumidor só.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAIR_QUEUE_LEN   QUEUE_LEN
+
+/* Contadores por fluxo: sent/dropped escritos pela fonte, served pela RX */
+typedef struct {
+    volatile uint32_t sent;
+    volatile uint32_t dropped;
+    volatile uint32_t served;
+} fair_stats_t;
+
+extern fair_stats_t g_fair_stats[FAIR_STREAMS];
+
+bool   fair_init(void);
+/* Enfileira na fila do fluxo item->key, sem esperar além de `wait` */
+bool   fair_send(const pipe_item_t *item, TickType_t wait);
+/* Próximo item pela ordem do DRR; false se nada chegar em `wait` */
+bool   fair_receive(pipe_item_t *out, TickType_t wait);
+size_t fair_waiting(int stream);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,104 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "fair.h"
+#include "fair_pipeline.h"
+
+#if APP_MODE_FAIR
+
+/* ==========================
+ *  PARÂMETROS
+ * ========================== */
+#define FAIR_RX_PER_TICK     8        // capacidade da RX: itens por tick
+#define FAIR_REPORT_MS       2000
+
+/* Oferta por fluxo em milésimos de item por tick (o fluxo 0 é o tagarela) */
+static const uint32_t k_rate_milli[FAIR_STREAMS] = { 16000, 4000, 400 };
+
+static lat_hist_t s_lat[FAIR_STREAMS];   // escritor: RX
+
+/* ==========================
+ *  Fonte: a cada tick, cada fluxo emite sua cota (com acumulador)
+ * ========================== */
+static void task_fair_source(void *pv) {
+    static int32_t seq[FAIR_STREAMS];
+    static uint32_t acc[FAIR_STREAMS];
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        uint32_t now = metrics_now_us();
+        for (uint32_t s = 0; s < FAIR_STREAMS; s++) {
+            acc[s] += k_rate_milli[s];
+            for (; acc[s] >= 1000; acc[s] -= 1000) {
+                pipe_item_t item = { .value = seq[s]++, .t_enq_us = now, .key = s };
+                fair_send(&item, 0);
+            }
+        }
+        xTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+/* ==========================
+ *  RX: até FAIR_RX_PER_TICK itens por tick, na ordem do DRR
+ * ========================== */
+static void task_fair_receiver(void *pv) {
+    TickType_t last_wake = xTaskGetTickCount();
+    for (;;) {
+        for (int n = 0; n < FAIR_RX_PER_TICK; n++) {
+            pipe_item_t item;
+            if (!fair_receive(&item, n == 0 ? portMAX_DELAY : 0)) {
+                break;
+            }
+            lat_hist_record(&s_lat[item.key], metrics_now_us() - item.t_enq_us);
+        }
+        /* Depois de uma espera longa o ritmo recomeça de agora */
+        TickType_t now = xTaskGetTickCount();
+        if (now - last_wake > 1) {
+            last_wake = now - 1;
+        }
+        xTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+void fair_pipeline_run(void) {
+    if (!fair_init()) {
+        PRINTF("[FAIR] ERRO: falha ao criar filas/queue set.\n");
+        return;
+    }
+    xTaskCreatePinnedToCore(task_fair_receiver, "task_fair_rx", RX_STACK_WORDS, NULL,
+                            RX_TASK_PRIO, NULL, APP_PIPE_CORE);
+    xTaskCreatePinnedToCore(task_fair_source, "task_fair_src", GEN_STACK_WORDS, NULL,
+                            GEN_TASK_PRIO, NULL, APP_PIPE_CORE);
+
+    static const int32_t weights[FAIR_STREAMS] = FAIR_WEIGHTS;
+    PRINTF("[FAIR] %d fluxos, RX atende %u itens/s.\n",
+           FAIR_STREAMS, (unsigned)(FAIR_RX_PER_TICK * configTICK_RATE_HZ));
+
+    fair_stats_t prev[FAIR_STREAMS] = { 0 };
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(FAIR_REPORT_MS));
+        for (int s = 0; s < FAIR_STREAMS; s++) {
+            fair_stats_t cur = g_fair_stats[s];
+            uint32_t offered = (cur.sent - prev[s].sent) + (cur.dropped - prev[s].dropped);
+            PRINTF("[FAIR] fluxo %d (peso %d): oferecido=%" PRIu32 " atendido=%" PRIu32
+                   " descartado=%" PRIu32 " itens/s, fila=%u, latência p50=%" PRIu32
+                   " p99=%" PRIu32 " max=%" PRIu32 " us\n",
+                   s, (int)weights[s],
+                   offered * 1000 / FAIR_REPORT_MS,
+                   (cur.served - prev[s].served) * 1000 / FAIR_REPORT_MS,
+                   (cur.dropped - prev[s].dropped) * 1000 / FAIR_REPORT_MS,
+                   (unsigned)fair_waiting(s),
+                   lat_hist_percentile(&s_lat[s], 50), lat_hist_percentile(&s_lat[s], 99),
+                   s_lat[s].max_us);
+            prev[s] = cur;
+        }
+    }
+}
+
+#endif // APP_MODE_FAIR
@@ -0,0 +1,21 @@
+#pragma once
+
+/* ==========================
+ *  Fluxos concorrentes numa RX com escalonamento justo (APP_MODE_FAIR)
+ *  Uma fonte gera FAIR_STREAMS fluxos com taxas bem diferentes (o fluxo
+ *  0 oferece sozinho mais que a capacidade da RX). A RX atende no máximo
+ *  FAIR_RX_PER_TICK itens por tick, escolhidos pelo DRR (fair.h).
+ *  Relatório periódico por fluxo: oferecido, atendido e descartado
+ *  (itens/s), fila e latência p50/p99/máx.
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria filas, fonte e RX; relata em seguida (bloqueante). */
+void fair_pipeline_run(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,445 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+#include "esp_task_wdt.h"
+#include "esp_heap_caps.h"
+
+#include "app_config.h"
+#include "fault.h"
+
+#if APP_FAULT_INJECTION
+
+#if CONFIG_IDF_TARGET_LINUX
+#include <poll.h>
+#include <unistd.h>
+#define FAULT_NOINIT
+#define FAULT_IRAM
+#else
+#include "esp_attr.h"
+#define FAULT_NOINIT           RTC_NOINIT_ATTR
+#define FAULT_IRAM             IRAM_ATTR
+#endif
+
+/* ==========================
+ *  PARÂMETROS DA INJEÇÃO
+ * ========================== */
+#define FAULT_TASK_PRIO          3        // abaixo do supervisor, acima do log
+#define FAULT_STACK_WORDS        3072
+#define FAULT_POLL_MS            50       // leitura do console / relatório
+#define FAULT_RECOVER_LIMIT_MS   60000    // sem recuperação até aqui → "não recuperou"
+#define FAULT_HEAP_FLOOR_BYTES   (6 * 1024)  // heap_exhaust consome até sobrar isto
+#define FAULT_HEAP_CHUNK_BYTES   512
+#define FAULT_HEAP_HOLD_MS       30000    // depois devolve a memória
+#define FAULT_STARVE_MS          ((WDT_TIMEOUT_SECONDS + 2) * 1000)
+#define FAULT_LINE_MAX           48
+#define FAULT_MAGIC              0x46414C54u  // "FALT"
+
+/* Agenda (APP_FAULT_SCHEDULE): instante desde o boot. As falhas que
+ * terminam em reinício ficam por último; o índice sobrevive ao reinício. */
+typedef struct {
+    uint32_t at_ms;
+    fault_id_t fault;
+} fault_sched_t;
+
+static const fault_sched_t k_schedule[] = {
+    {  30000, FAULT_QUEUE_STALL  },
+    {  90000, FAULT_MALLOC_FAIL  },
+    { 150000, FAULT_RX_HANG      },
+    { 210000, FAULT_GEN_HANG     },
+    { 270000, FAULT_HEAP_EXHAUST },
+    { 330000, FAULT_WDT_STARVE   },
+};
+#define FAULT_SCHED_LEN  (sizeof(k_schedule) / sizeof(k_schedule[0]))
+
+static const char *const k_fault_names[FAULT_COUNT] = {
+    [FAULT_NONE]         = "none",
+    [FAULT_GEN_HANG]     = "gen_hang",
+    [FAULT_RX_HANG]      = "rx_hang",
+    [FAULT_QUEUE_STALL]  = "queue_stall",
+    [FAULT_MALLOC_FAIL]  = "malloc_fail",
+    [FAULT_HEAP_EXHAUST] = "heap_exhaust",
+    [FAULT_WDT_STARVE]   = "wdt_starve",
+};
+
+static const char *const k_event_names[FAULT_EV_COUNT] = {
+    [FAULT_EV_RX_TIMEOUT]      = "rx_timeout",
+    [FAULT_EV_RX_MALLOC_FAIL]  = "rx_malloc_fail",
+    [FAULT_EV_QUEUE_RESET]     = "queue_reset",
+    [FAULT_EV_SUP_GEN_RESTART] = "sup_gen_restart",
+    [FAULT_EV_SUP_RX_RESTART]  = "sup_rx_restart",
+    [FAULT_EV_HEAP_CRITICAL]   = "heap_critical",
+    [FAULT_EV_WDT]             = "task_wdt",
+};
+
+/* Medição em andamento. Em RTC_NOINIT para sobreviver a esp_restart e ao
+ * pânico do WDT; magic inválido (power-on) → zera tudo. Tempos em us de
+ * esp_timer, que recomeça no boot: após reinício só os deltas já
+ * fechados antes do reset continuam válidos. */
+typedef struct {
+    uint32_t magic;
+    uint32_t fault;
+    uint32_t event;
+    uint32_t sched_next;
+    uint32_t pending_reboot;   // detecção gravada e o chip reiniciou
+    int64_t t_inject_us;
+    int64_t t_detect_us;
+} fault_record_t;
+
+static FAULT_NOINIT fault_record_t s_rec;
+
+/* Estatística por falha (desde o boot) */
+typedef struct {
+    uint32_t count;
+    uint32_t recovered;
+    uint64_t detect_sum_us;
+    uint64_t recover_sum_us;
+    uint32_t detect_max_us;
+    uint32_t recover_max_us;
+} fault_stats_t;
+
+static fault_stats_t s_stats[FAULT_COUNT];
+
+volatile fault_id_t g_fault_armed = FAULT_NONE;
+volatile bool g_fault_tracking = false;
+volatile bool g_fault_stalled = false;
+
+static volatile bool s_detect_reported = false;
+static volatile int64_t s_t_recover_us = 0;
+static void *s_heap_hog = NULL;
+static int64_t s_heap_hog_until_us = 0;
+
+/* ==========================
+ *  Pontos de medição (chamados pela pipeline)
+ * ========================== */
+void fault_note(fault_event_t ev) {
+    if (!g_fault_tracking || s_rec.t_detect_us != 0) {
+        return;
+    }
+    s_rec.event = ev;
+    s_rec.t_detect_us = esp_timer_get_time();
+}
+
+void fault_note_recovered(void) {
+    if (s_rec.t_detect_us != 0 && s_t_recover_us == 0) {
+        s_t_recover_us = esp_timer_get_time();
+    }
+}
+
+/* Chamado pelo ISR do Task WDT antes do pânico: só grava o registro */
+void FAULT_IRAM esp_task_wdt_isr_user_handler(void) {
+    if (g_fault_tracking && s_rec.t_detect_us == 0) {
+        s_rec.event = FAULT_EV_WDT;
+        s_rec.t_detect_us = esp_timer_get_time();
+    }
+}
+
+void fault_hang(void) {
+    for (;;) {
+        vTaskDelay(portMAX_DELAY);
+    }
+}
+
+/* ==========================
+ *  Injeção
+ * ========================== */
+static void heap_hog_fill(void) {
+    while (heap_caps_get_free_size(MALLOC_CAP_DEFAULT) > FAULT_HEAP_FLOOR_BYTES + FAULT_HEAP_CHUNK_BYTES) {
+        void **chunk = malloc(FAULT_HEAP_CHUNK_BYTES);
+        if (!chunk) {
+            break;
+        }
+        *chunk = s_heap_hog;   // lista encadeada pelos próprios blocos
+        s_heap_hog = chunk;
+    }
+    s_heap_hog_until_us = esp_timer_get_time() + (int64_t)FAULT_HEAP_HOLD_MS * 1000;
+}
+
+static void heap_hog_release(void) {
+    while (s_heap_hog) {
+        void *next = *(void **)s_heap_hog;
+        free(s_heap_hog);
+        s_heap_hog = next;
+    }
+}
+
+/* Ocupa o núcleo da pipeline acima de todas as tarefas sem ceder a CPU:
+ * nenhuma tarefa vinculada ao WDT consegue resetá-lo. */
+static void starve_task(void *pv) {
+    int64_t until = esp_timer_get_time() + (int64_t)FAULT_STARVE_MS * 1000;
+    while (esp_timer_get_time() < until) {
+    }
+    vTaskDelete(NULL);
+}
+
+bool fault_inject(fault_id_t fault) {
+    if (fault <= FAULT_NONE || fault >= FAULT_COUNT) {
+        return false;
+    }
+#if APP_VIRTUAL_TIME
+    /* Com a CPU presa o relógio virtual não anda: a fome nunca terminaria */
+    if (fault == FAULT_WDT_STARVE) {
+        PRINTF("[FAULT] wdt_starve indisponível com APP_VIRTUAL_TIME.\n");
+        return false;
+    }
+#endif
+    if (g_fault_tracking) {
+        PRINTF("[FAULT] Medição de %s ainda em andamento – injeção ignorada.\n",
+               k_fault_names[s_rec.fault]);
+        return false;
+    }
+
+    s_rec.fault = fault;
+    s_rec.t_detect_us = 0;
+    s_rec.pending_reboot = 0;
+    s_t_recover_us = 0;
+    s_detect_reported = false;
+    s_rec.t_inject_us = esp_timer_get_time();
+    g_fault_tracking = true;
+
+    PRINTF("[FAULT] Injetando %s.\n", k_fault_names[fault]);
+
+    switch (fault) {
+    case FAULT_GEN_HANG:
+    case FAULT_RX_HANG:
+    case FAULT_MALLOC_FAIL:
+        g_fault_armed = fault;   // consumida pelo próprio estágio (fault_take)
+        break;
+    case FAULT_QUEUE_STALL:
+        g_fault_stalled = true;  // só um reset da fila desfaz
+        break;
+    case FAULT_HEAP_EXHAUST:
+        heap_hog_fill();
+        break;
+    case FAULT_WDT_STARVE:
+        xTaskCreatePinnedToCore(starve_task, "fault_starve", 2048, NULL,
+                                configMAX_PRIORITIES - 1, NULL, APP_PIPE_CORE);
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+static void fault_clear(void) {
+    g_fault_armed = FAULT_NONE;
+    g_fault_stalled = false;
+    heap_hog_release();
+    g_fault_tracking = false;
+    s_rec.pending_reboot = 0;
+}
+
+/* ==========================
+ *  Relatório
+ * ========================== */
+static void stats_add(fault_id_t f, int64_t detect_us, int64_t recover_us) {
+    fault_stats_t *s = &s_stats[f];
+    s->count++;
+    s->detect_sum_us += (uint64_t)detect_us;
+    if (detect_us > s->detect_max_us) {
+        s->detect_max_us = (uint32_t)detect_us;
+    }
+    if (recover_us >= 0) {
+        s->recovered++;
+        s->recover_sum_us += (uint64_t)recover_us;
+        if (recover_us > s->recover_max_us) {
+            s->recover_max_us = (uint32_t)recover_us;
+        }
+    }
+}
+
+static void print_stats(void) {
+    PRINTF("[FAULT] %-13s %5s %5s %12s %12s %12s %12s\n",
+           "falha", "n", "recup", "det_med_ms", "det_max_ms", "mttr_ms", "mttr_max_ms");
+    for (int f = FAULT_NONE + 1; f < FAULT_COUNT; f++) {
+        const fault_stats_t *s = &s_stats[f];
+        if (!s->count) {
+            continue;
+        }
+        PRINTF("[FAULT] %-13s %5" PRIu32 " %5" PRIu32 " %12" PRIu32 " %12" PRIu32 " %12" PRIu32
+               " %12" PRIu32 "\n",
+               k_fault_names[f], s->count, s->recovered,
+               (uint32_t)(s->detect_sum_us / s->count / 1000), s->detect_max_us / 1000,
+               s->recovered ? (uint32_t)(s->recover_sum_us / s->recovered / 1000) : 0,
+               s->recover_max_us / 1000);
+    }
+}
+
+/* Avança a medição em andamento; chamado periodicamente pela tarefa */
+static void track_poll(void) {
+    int64_t now = esp_timer_get_time();
+
+    if (s_heap_hog && now >= s_heap_hog_until_us) {
+        PRINTF("[FAULT] heap_exhaust: devolvendo memória retida.\n");
+        heap_hog_release();
+    }
+    if (!g_fault_tracking) {
+        return;
+    }
+
+    fault_id_t f = (fault_id_t)s_rec.fault;
+
+    if (s_rec.pending_reboot) {
+        /* Detecção aconteceu antes do reinício; esp_timer conta desde o boot */
+        if (s_t_recover_us) {
+            int64_t detect = s_rec.t_detect_us - s_rec.t_inject_us;
+            int64_t recover = detect + s_t_recover_us;
+            PRINTF("[FAULT] %s: recuperado após reinício – detecção %" PRId64 " ms, "
+                   "MTTR >= %" PRId64 " ms (boot até 1º item: %" PRId64 " ms).\n",
+                   k_fault_names[f], detect / 1000, recover / 1000, s_t_recover_us / 1000);
+            stats_add(f, detect, recover);
+            fault_clear();
+        }
+        return;
+    }
+
+    if (s_rec.t_detect_us && !s_detect_reported) {
+        s_detect_reported = true;
+        PRINTF("[FAULT] %s: detectado por %s em %" PRId64 " ms.\n",
+               k_fault_names[f], k_event_names[s_rec.event],
+               (s_rec.t_detect_us - s_rec.t_inject_us) / 1000);
+    }
+
+    if (s_t_recover_us) {
+        int64_t detect = s_rec.t_detect_us - s_rec.t_inject_us;
+        int64_t recover = s_t_recover_us - s_rec.t_inject_us;
+        PRINTF("[FAULT] %s: recuperado – detecção %" PRId64 " ms, MTTR %" PRId64 " ms.\n",
+               k_fault_names[f], detect / 1000, recover / 1000);
+        stats_add(f, detect, recover);
+        fault_clear();
+    } else if (now - s_rec.t_inject_us > (int64_t)FAULT_RECOVER_LIMIT_MS * 1000) {
+        PRINTF("[FAULT] %s: NÃO recuperou em %u ms (%s).\n", k_fault_names[f],
+               (unsigned)FAULT_RECOVER_LIMIT_MS, s_rec.t_detect_us ? "detectado" : "não detectado");
+        stats_add(f, s_rec.t_detect_us ? s_rec.t_detect_us - s_rec.t_inject_us : now - s_rec.t_inject_us, -1);
+        fault_clear();
+    }
+}
+
+/* ==========================
+ *  Console: uma linha por comando
+ * ========================== */
+static fault_id_t fault_by_name(const char *name) {
+    for (int f = FAULT_NONE + 1; f < FAULT_COUNT; f++) {
+        if (strcmp(name, k_fault_names[f]) == 0) {
+            return (fault_id_t)f;
+        }
+    }
+    return FAULT_NONE;
+}
+
+static void console_exec(char *line) {
+    if (strncmp(line, "fault", 5) != 0) {
+        return;
+    }
+    char *arg = line + 5;
+    while (*arg == ' ') {
+        arg++;
+    }
+
+    if (strcmp(arg, "list") == 0 || *arg == '\0') {
+        PRINTF("[FAULT] Falhas:");
+        for (int f = FAULT_NONE + 1; f < FAULT_COUNT; f++) {
+            printf(" %s", k_fault_names[f]);
+        }
+        printf(" | comandos: list, stats, clear\n");
+    } else if (strcmp(arg, "stats") == 0) {
+        print_stats();
+    } else if (strcmp(arg, "clear") == 0) {
+        fault_clear();
+        PRINTF("[FAULT] Falhas ativas removidas.\n");
+    } else {
+        fault_id_t f = fault_by_name(arg);
+        if (f == FAULT_NONE) {
+            PRINTF("[FAULT] Falha desconhecida: %s\n", arg);
+        } else {
+            fault_inject(f);
+        }
+    }
+}
+
+/* Leitura não bloqueante: no ESP32 o stdin do console já não bloqueia sem
+ * driver de UART. No linux não dá para pôr o fd 0 em O_NONBLOCK: num tty
+ * ele divide a descrição de arquivo com o stdout, e os printf passariam a
+ * falhar com EAGAIN. poll() com timeout zero + read() de um byte (sem o
+ * buffer do stdio, que bloquearia ao esvaziar) não para o escalonador
+ * POSIX nem o relógio virtual. */
+static int console_getc(void) {
+#if CONFIG_IDF_TARGET_LINUX
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    unsigned char ch;
+    if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & POLLIN) || read(STDIN_FILENO, &ch, 1) != 1) {
+        return EOF;
+    }
+    return ch;
+#else
+    return getchar();
+#endif
+}
+
+static void console_poll(char *buf, size_t *len) {
+    int c;
+    while ((c = console_getc()) != EOF) {
+        if (c == '\r') {
+            continue;
+        }
+        if (c == '\n') {
+            buf[*len] = '\0';
+            console_exec(buf);
+            *len = 0;
+        } else if (*len < FAULT_LINE_MAX - 1) {
+            buf[(*len)++] = (char)c;
+        }
+    }
+    clearerr(stdin);
+}
+
+static void task_fault(void *pv) {
+    char line[FAULT_LINE_MAX];
+    size_t len = 0;
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(FAULT_POLL_MS));
+        console_poll(line, &len);
+        track_poll();
+
+#if APP_FAULT_SCHEDULE
+        if (!g_fault_tracking && s_rec.sched_next < FAULT_SCHED_LEN &&
+            esp_timer_get_time() >= (int64_t)k_schedule[s_rec.sched_next].at_ms * 1000) {
+            fault_inject(k_schedule[s_rec.sched_next++].fault);
+            if (s_rec.sched_next == FAULT_SCHED_LEN) {
+                PRINTF("[FAULT] Agenda concluída.\n");
+            }
+        }
+#endif
+    }
+}
+
+void fault_init(void) {
+    if (s_rec.magic != FAULT_MAGIC) {
+        memset(&s_rec, 0, sizeof(s_rec));
+        s_rec.magic = FAULT_MAGIC;
+    } else if (s_rec.fault > FAULT_NONE && s_rec.fault < FAULT_COUNT && s_rec.t_detect_us) {
+        /* Reinício durante uma medição: a recuperação é o 1º item deste boot */
+        PRINTF("[FAULT] %s detectado por %s em %" PRId64 " ms antes do reinício.\n",
+               k_fault_names[s_rec.fault], k_event_names[s_rec.event],
+               (s_rec.t_detect_us - s_rec.t_inject_us) / 1000);
+        s_rec.pending_reboot = 1;
+        s_t_recover_us = 0;
+        g_fault_tracking = true;
+    } else {
+        s_rec.fault = FAULT_NONE;
+    }
+
+    PRINTF("[FAULT] Injeção de falhas ativa (agenda %s). Digite \"fault list\".\n",
+           APP_FAULT_SCHEDULE ? "ligada" : "desligada");
+    xTaskCreatePinnedToCore(task_fault, "task_fault", FAULT_STACK_WORDS, NULL,
+                            FAULT_TASK_PRIO, NULL, 0);
+}
+
+#endif // APP_FAULT_INJECTION
@@ -0,0 +1,102 @@
+#pragma once
+
+/* ==========================
+ *  Injeção de falhas + medição de MTTR (APP_FAULT_INJECTION)
+ *
+ *  Falhas: gen_hang, rx_hang, queue_stall, malloc_fail, heap_exhaust,
+ *  wdt_starve. Disparo pelo console ("fault <nome>", "fault list",
+ *  "fault stats", "fault clear") ou pela agenda (APP_FAULT_SCHEDULE).
+ *
+ *  Para cada injeção mede:
+ *    detecção   = injeção → primeira reação da pipeline (timeout da RX,
+ *                 reset da fila, recriação pelo supervisor, heap crítico,
+ *                 disparo do Task WDT...)
+ *    recuperação = injeção → primeiro item processado depois da detecção
+ *  O registro fica em RTC_NOINIT, então falhas que terminam em reinício
+ *  (WDT, heap) são medidas no boot seguinte.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FAULT_NONE = 0,
+    FAULT_GEN_HANG,
+    FAULT_RX_HANG,
+    FAULT_QUEUE_STALL,
+    FAULT_MALLOC_FAIL,
+    FAULT_HEAP_EXHAUST,
+    FAULT_WDT_STARVE,
+    FAULT_COUNT
+} fault_id_t;
+
+/* Reações da pipeline que contam como detecção */
+typedef enum {
+    FAULT_EV_RX_TIMEOUT = 0,
+    FAULT_EV_RX_MALLOC_FAIL,
+    FAULT_EV_QUEUE_RESET,
+    FAULT_EV_SUP_GEN_RESTART,
+    FAULT_EV_SUP_RX_RESTART,
+    FAULT_EV_HEAP_CRITICAL,
+    FAULT_EV_WDT,
+    FAULT_EV_COUNT
+} fault_event_t;
+
+#if APP_FAULT_INJECTION
+
+extern volatile fault_id_t g_fault_armed;   // falha one-shot aguardando o estágio alvo
+extern volatile bool g_fault_tracking;      // medição em andamento
+extern volatile bool g_fault_stalled;       // queue_stall ativo
+
+/* Inicia console/agenda e reporta medição pendente de antes do reinício */
+void fault_init(void);
+bool fault_inject(fault_id_t fault);
+void fault_note(fault_event_t ev);
+void fault_note_recovered(void);
+/* Bloqueia a tarefa chamadora para sempre (simula travamento) */
+void fault_hang(void);
+
+/* Consome a injeção armada se for para este estágio */
+static inline bool fault_take(fault_id_t fault) {
+    if (g_fault_armed != fault) {
+        return false;
+    }
+    g_fault_armed = FAULT_NONE;
+    return true;
+}
+
+static inline bool fault_queue_stalled(void) { return g_fault_stalled; }
+
+/* Reset da fila pela RX: é detecção e também desfaz o queue_stall */
+static inline void fault_on_queue_reset(void) {
+    fault_note(FAULT_EV_QUEUE_RESET);
+    g_fault_stalled = false;
+}
+
+static inline void fault_on_consumed(void) {
+    if (g_fault_tracking) {
+        fault_note_recovered();
+    }
+}
+
+#else
+
+static inline void fault_init(void) {}
+static inline void fault_note(fault_event_t ev) { (void)ev; }
+static inline void fault_hang(void) {}
+static inline bool fault_take(fault_id_t fault) { (void)fault; return false; }
+static inline bool fault_queue_stalled(void) { return false; }
+static inline void fault_on_queue_reset(void) {}
+static inline void fault_on_consumed(void) {}
+
+#endif // APP_FAULT_INJECTION
+
+#ifdef __cplusplus
+}
+#endif
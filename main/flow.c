@@ -0,0 +1,139 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "flow.h"
+
+flow_t g_pipe_flow;
+
+#if APP_FLOW_CONTROL
+
+void flow_init(flow_t *f, uint32_t high_wm, uint32_t low_wm) {
+    memset(f, 0, sizeof(*f));
+    f->lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    f->credits = (int32_t)high_wm;
+    f->high_wm = high_wm;
+    f->low_wm = low_wm;
+}
+
+/* Com a trava: entra/sai da lista de espera. Lista cheia: o produtor
+ * extra não é registrado e volta a tentar a cada tick */
+static bool add_waiter(flow_t *f, TaskHandle_t t) {
+    for (uint8_t i = 0; i < f->n_waiters; i++) {
+        if (f->waiters[i] == t) {
+            return true;
+        }
+    }
+    if (f->n_waiters >= FLOW_MAX_WAITERS) {
+        return false;
+    }
+    f->waiters[f->n_waiters++] = t;
+    return true;
+}
+
+static void remove_waiter(flow_t *f, TaskHandle_t t) {
+    for (uint8_t i = 0; i < f->n_waiters; i++) {
+        if (f->waiters[i] == t) {
+            f->waiters[i] = f->waiters[--f->n_waiters];
+            return;
+        }
+    }
+}
+
+/* Com a trava: sai da pausa se já baixou para low_wm em voo. Copia os
+ * produtores a acordar para `wake` (notificados depois de soltar a trava) */
+static uint8_t maybe_resume(flow_t *f, TaskHandle_t wake[FLOW_MAX_WAITERS]) {
+    if (!f->throttled || f->credits < (int32_t)(f->high_wm - f->low_wm)) {
+        return 0;
+    }
+    f->throttled = false;
+    f->stats.throttled_us += esp_timer_get_time() - f->throttled_since;
+    uint8_t n = f->n_waiters;
+    memcpy(wake, f->waiters, n * sizeof(TaskHandle_t));
+    f->n_waiters = 0;
+    return n;
+}
+
+/* Com a trava: entra em pausa ao zerar os créditos */
+static void throttle(flow_t *f) {
+    f->throttled = true;
+    f->throttled_since = esp_timer_get_time();
+    f->stats.throttles++;
+}
+
+static void wake_all(TaskHandle_t wake[FLOW_MAX_WAITERS], uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        xTaskNotifyGive(wake[i]);
+    }
+}
+
+bool flow_acquire(flow_t *f, TickType_t wait) {
+    TickType_t start = xTaskGetTickCount();
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (;;) {
+        portENTER_CRITICAL(&f->lock);
+        if (!f->throttled && f->credits > 0) {
+            remove_waiter(f, self);
+            f->credits--;
+            f->stats.spent++;
+            if (f->credits == 0) {
+                throttle(f);
+            }
+            portEXIT_CRITICAL(&f->lock);
+            return true;
+        }
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (wait != portMAX_DELAY && elapsed >= wait) {
+            f->stats.refused++;
+            remove_waiter(f, self);
+            portEXIT_CRITICAL(&f->lock);
+            return false;
+        }
+        bool registered = add_waiter(f, self);
+        portEXIT_CRITICAL(&f->lock);
+        TickType_t left = wait == portMAX_DELAY ? portMAX_DELAY : wait - elapsed;
+        ulTaskNotifyTake(pdTRUE, registered ? left : 1);
+    }
+}
+
+void flow_grant(flow_t *f, uint32_t n) {
+    portENTER_CRITICAL(&f->lock);
+    f->credits += (int32_t)n;
+    if (f->credits > (int32_t)f->high_wm) {
+        f->credits = (int32_t)f->high_wm;
+    }
+    f->stats.granted += n;
+    TaskHandle_t wake[FLOW_MAX_WAITERS];
+    uint8_t n_wake = maybe_resume(f, wake);
+    portEXIT_CRITICAL(&f->lock);
+    wake_all(wake, n_wake);
+}
+
+void flow_resync(flow_t *f, uint32_t in_flight) {
+    portENTER_CRITICAL(&f->lock);
+    f->credits = in_flight >= f->high_wm ? 0 : (int32_t)(f->high_wm - in_flight);
+    /* Sem créditos o produtor precisa pausar como no flow_acquire, senão
+     * voltaria a produzir no primeiro grant em vez de esperar o low_wm */
+    if (f->credits == 0 && !f->throttled) {
+        throttle(f);
+    }
+    TaskHandle_t wake[FLOW_MAX_WAITERS];
+    uint8_t n_wake = maybe_resume(f, wake);
+    portEXIT_CRITICAL(&f->lock);
+    wake_all(wake, n_wake);
+}
+
+void flow_get_stats(flow_t *f, flow_stats_t *out, int32_t *credits) {
+    portENTER_CRITICAL(&f->lock);
+    *out = f->stats;
+    if (f->throttled) {
+        out->throttled_us += esp_timer_get_time() - f->throttled_since;
+    }
+    *credits = f->credits;
+    portEXIT_CRITICAL(&f->lock);
+}
+
+#endif // APP_FLOW_CONTROL
@@ -0,0 +1,82 @@
+#pragma once
+
+/* ==========================
+ *  Controle de fluxo por créditos entre dois estágios
+ *  O consumidor concede créditos ao terminar cada item; o produtor gasta
+ *  um por item antes de enviar. Créditos = high_wm - itens em voo, então
+ *  a fila nunca passa de high_wm e o produtor sabe que está adiantado
+ *  antes de um envio falhar.
+ *
+ *  Histerese: ao zerar os créditos (high_wm em voo) o produtor fica
+ *  pausado até o consumidor baixar para low_wm em voo; não oscila item a
+ *  item na borda. Pausas, tempo pausado e recusas ficam contados: a
+ *  contrapressão é explícita e medida, e não descarte cego.
+ *
+ *  Um flow_t por fronteira; hoje só GERADOR→RX (g_pipe_flow). A saída da
+ *  RX para os sinks (sink.h) não tem crédito de propósito: cada sink
+ *  descarta pela própria política em vez de segurar a RX.
+ *
+ *  Até FLOW_MAX_WAITERS produtores podem esperar crédito na mesma
+ *  fronteira; ao sair da pausa todos são acordados e disputam os créditos.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t spent;          // créditos usados (itens enviados)
+    uint32_t granted;        // créditos devolvidos pelo consumidor
+    uint32_t throttles;      // vezes que o produtor foi pausado
+    uint32_t refused;        // flow_acquire que desistiu (produtor adiou)
+    uint64_t throttled_us;   // tempo total pausado
+} flow_stats_t;
+
+#define FLOW_MAX_WAITERS  4
+
+typedef struct {
+    portMUX_TYPE lock;
+    int32_t  credits;
+    uint32_t high_wm;
+    uint32_t low_wm;
+    bool     throttled;
+    int64_t  throttled_since;
+    TaskHandle_t waiters[FLOW_MAX_WAITERS];   // produtores esperando crédito
+    uint8_t  n_waiters;
+    flow_stats_t stats;
+} flow_t;
+
+/* Fronteira GERADOR→RX da pipeline */
+extern flow_t g_pipe_flow;
+
+#if APP_FLOW_CONTROL
+
+void flow_init(flow_t *f, uint32_t high_wm, uint32_t low_wm);
+/* Produtor: gasta um crédito; espera até `wait` se estiver pausado */
+bool flow_acquire(flow_t *f, TickType_t wait);
+/* Consumidor: devolve n créditos (itens terminados) */
+void flow_grant(flow_t *f, uint32_t n);
+/* Após reset/recuperação do canal: recalcula a partir do que está em voo */
+void flow_resync(flow_t *f, uint32_t in_flight);
+void flow_get_stats(flow_t *f, flow_stats_t *out, int32_t *credits);
+
+#else
+
+static inline void flow_init(flow_t *f, uint32_t high_wm, uint32_t low_wm) { (void)f; (void)high_wm; (void)low_wm; }
+static inline bool flow_acquire(flow_t *f, TickType_t wait) { (void)f; (void)wait; return true; }
+static inline void flow_grant(flow_t *f, uint32_t n) { (void)f; (void)n; }
+static inline void flow_resync(flow_t *f, uint32_t in_flight) { (void)f; (void)in_flight; }
+
+#endif // APP_FLOW_CONTROL
+
+#ifdef __cplusplus
+}
+#endif
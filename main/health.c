@@ -0,0 +1,42 @@
+#include <stdatomic.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "health.h"
+
+/* Par = estável, ímpar = escrita em andamento */
+static atomic_uint s_seq;
+static health_data_t s_data;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+health_data_t *health_write_begin(void) {
+    portENTER_CRITICAL(&s_lock);
+    unsigned seq = atomic_load_explicit(&s_seq, memory_order_relaxed);
+    atomic_store_explicit(&s_seq, seq + 1, memory_order_relaxed);
+    /* Os dados só podem ser escritos depois que o ímpar ficar visível */
+    atomic_thread_fence(memory_order_release);
+    return &s_data;
+}
+
+void health_write_end(void) {
+    unsigned seq = atomic_load_explicit(&s_seq, memory_order_relaxed);
+    atomic_store_explicit(&s_seq, seq + 1, memory_order_release);
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void health_snapshot(health_data_t *out) {
+    unsigned s1, s2;
+    do {
+        s1 = atomic_load_explicit(&s_seq, memory_order_acquire);
+        if (s1 & 1u) {
+            continue;   // escritor no outro núcleo: dura poucas instruções
+        }
+        memcpy(out, &s_data, sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        s2 = atomic_load_explicit(&s_seq, memory_order_relaxed);
+        if (s1 == s2) {
+            return;
+        }
+    } while (1);
+}
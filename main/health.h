@@ -0,0 +1,54 @@
+#pragma once
+
+/* ==========================
+ *  Estado de saúde da pipeline (heartbeats + flags) sob seqlock
+ *  Escritores (estágios e supervisor) atualizam dentro de
+ *  health_write_begin/end: seção crítica curta, então um escritor nunca é
+ *  preemptado no meio e escritores de núcleos diferentes se serializam.
+ *  Leitores (supervisor, logger, telemetria) copiam tudo com
+ *  health_snapshot: sem trava, refazem a cópia se um escritor passou no
+ *  meio; a visão é sempre consistente.
+ *
+ *  Campos novos entram em health_data_t; nenhum ponto de leitura muda.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    TickType_t hb[STAGE_COUNT];   // último heartbeat do estágio (ticks)
+    bool ok[STAGE_COUNT];         // flag de saúde do estágio
+} health_data_t;
+
+/* Abre a escrita e devolve os dados vivos; fechar com health_write_end */
+health_data_t *health_write_begin(void);
+void health_write_end(void);
+
+/* Cópia consistente sem bloquear escritores */
+void health_snapshot(health_data_t *out);
+
+/* Heartbeat + flag numa escrita só */
+static inline void health_set(stage_id_t stage, TickType_t hb, bool ok) {
+    health_data_t *h = health_write_begin();
+    h->hb[stage] = hb;
+    h->ok[stage] = ok;
+    health_write_end();
+}
+
+static inline void health_set_ok(stage_id_t stage, bool ok) {
+    health_data_t *h = health_write_begin();
+    h->ok[stage] = ok;
+    health_write_end();
+}
+
+#ifdef __cplusplus
+}
+#endif
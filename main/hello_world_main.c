@@ -11,93 +11,142 @@
 #include "esp_task_wdt.h"
 #include "esp_heap_caps.h"
 
-/* ==========================
- *  CONFIGURAÇÕES GERAIS
- * ========================== */
-
-/* Identificação obrigatória em TODOS os prints oi */
-#define STUDENT_PREFIX "{Pedro Modesto Mesquita-RM:87880} "
-#define PRINTF(fmt, ...) printf(STUDENT_PREFIX fmt, ##__VA_ARGS__)
-
-/* Prioridades (maior número = maior prioridade) */
-#define GEN_TASK_PRIO      6   // Módulo 1 – Geração de Dados
-#define RX_TASK_PRIO       5   // Módulo 2 – Recepção/Transmissão
-#define SUP_TASK_PRIO      4   // Módulo 3 – Supervisão
-#define LOG_TASK_PRIO      2   // Extra – Log periódico (opcional)
-
-/* Tamanhos de pilha (em words) */
-#define GEN_STACK_WORDS    4096
-#define RX_STACK_WORDS     4096
-#define SUP_STACK_WORDS    4096
-#define LOG_STACK_WORDS    3072
-
-/* Fila */
-#define QUEUE_LEN          10
-#define QUEUE_ITEM_SIZE    sizeof(int)
-
-/* Temporizações */
-#define GEN_PERIOD_MS            150
-#define RX_TIMEOUT_MS            1000
-#define SUP_PERIOD_MS            1500
-#define STALL_TICKS(ms)          pdMS_TO_TICKS(ms)
-
-/* Escalonamento de reações na RX */
-#define RX_WARN_THRESHOLD        2   // n° de timeouts para aviso leve
-#define RX_RECOVER_SOFT          3   // tentativa leve (limpeza de estado)
-#define RX_RECOVER_RESET_Q       4   // reset da fila
-#define RX_FAIL_THRESHOLD        5   // encerra tarefa para o supervisor recriar
-
-/* Watchdog (Task WDT) */
-#define WDT_TIMEOUT_SECONDS      5
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "metrics.h"
+#include "traffic.h"
+#include "ipc_bench.h"
+#include "stress.h"
+#include "icount_bench.h"
+#include "soak.h"
+#include "fault.h"
+#include "rx_rto.h"
+#include "shed.h"
+#include "wdt_proxy.h"
+#include "swdt.h"
+#include "health.h"
+#include "svc.h"
+#include "coro_pipeline.h"
+#include "cyclic.h"
+#include "parallel.h"
+#include "shard_pipeline.h"
+#include "fair_pipeline.h"
+#include "lane_pipeline.h"
+#include "flow.h"
+#include "sink.h"
+#include "bus.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+#include "vclock.h"
+#endif
 
 /* ==========================
  *  ESTADO GLOBAL
  * ========================== */
-static QueueHandle_t g_queue = NULL;
 static TaskHandle_t g_task_gen = NULL;
 static TaskHandle_t g_task_rx  = NULL;
 static TaskHandle_t g_task_sup = NULL;
 static TaskHandle_t g_task_log = NULL; // opcional
 
-/* Heartbeats e flags de saúde */
-static volatile TickType_t g_hb_gen = 0;
-static volatile TickType_t g_hb_rx  = 0;
-static volatile TickType_t g_hb_sup = 0;
+/* Heartbeats e flags de saúde: health.h (seqlock) */
+
+#if !APP_SERVICE_TIMERS
+static void task_logger(void *pv); // recriada pelo supervisor (degradação)
+#endif
+
+static void sup_notify(uint32_t bits);
+
+/* Recriação cooperativa (swdt): o supervisor pede, a tarefa sai no início
+ * da volta seguinte – sem buffer, crédito ou item em mãos, nem no meio de
+ * um printf – e avisa o supervisor para recriá-la já. vTaskDelete à força
+ * só para quem também perdeu o heartbeat (travada de verdade) */
+static volatile bool s_stop_req[STAGE_COUNT];
+
+/* Bit de "tarefa saiu", entregue pelo mesmo caminho dos bits do swdt */
+#define SUP_EXITED_BIT(stage)   (1u << ((stage) + 16))
 
-static volatile bool g_flag_gen_ok = false;
-static volatile bool g_flag_rx_ok  = false;
+static void stage_exit(stage_id_t stage, TaskHandle_t *handle) {
+    wdt_unsubscribe(stage);   // o WDT não deve disparar por uma saída intencional
+    swdt_disarm(stage);
+    *handle = NULL;
+    sup_notify(SUP_EXITED_BIT(stage));
+    vTaskDelete(NULL);
+}
+
+/* Intervalos longos (off do bursty << degradação, vale do diurnal) são
+ * dormidos em fatias de GEN_MAX_SLEEP_MS com batida entre elas; cada fatia
+ * fica abaixo do Task WDT e do limite de heartbeat do supervisor */
+_Static_assert(GEN_MAX_SLEEP_MS < WDT_TIMEOUT_SECONDS * 1000, "fatia do gerador >= Task WDT");
+_Static_assert(GEN_MAX_SLEEP_MS < 3 * SUP_PERIOD_MS, "fatia do gerador >= limite de heartbeat");
+/* Maior silêncio agendado ainda cabe no prazo de swdt_expect (uint32 em µs) */
+_Static_assert((uint64_t)TRAFFIC_BURST_OFF_MS * 1000 << SHED_MAX_SLOW_SHIFT <= UINT32_MAX,
+               "off do bursty degradado estoura o prazo do swdt");
+
+static void gen_slice_beat(void) {
+    health_set(STAGE_GEN, xTaskGetTickCount(), true);
+    wdt_beat(STAGE_GEN);
+}
 
 /* ==========================
  *  MÓDULO 1 – Geração de Dados
- *  Produz inteiros sequenciais; envia para a fila; descarta se cheia.
+ *  Produz inteiros sequenciais no ritmo do perfil de tráfego configurado;
+ *  envia para a fila se houver crédito (flow.h), senão segura o valor e
+ *  tenta de novo na próxima chegada; descarta se a fila estiver cheia.
  * ========================== */
 static void task_generator(void *pv) {
-    /* Vincula esta tarefa ao Task Watchdog */
-    esp_task_wdt_add(NULL);
+    /* Vincula esta tarefa ao Task Watchdog (via proxy de heartbeat) */
+    wdt_subscribe(STAGE_GEN);
+
+    traffic_cfg_t traffic_cfg;
+    traffic_t traffic;
+    traffic_default_cfg(&traffic_cfg);
+    traffic_init(&traffic, &traffic_cfg);
 
     int value = 0;
-    for (;;) {
-        /* Tenta enviar sem bloquear; se a fila estiver cheia, descarta */
-        if (xQueueSend(g_queue, &value, 0) == pdTRUE) {
-            g_hb_gen = xTaskGetTickCount();
-            g_flag_gen_ok = true;
+    while (!s_stop_req[STAGE_GEN]) {
+        if (fault_take(FAULT_GEN_HANG)) {
+            fault_hang();
+        }
+
+        pipe_item_t item = { .value = value, .t_enq_us = metrics_now_us() };
+
+        /* Sem crédito a RX está atrasada: a fonte desacelera em vez de
+         * descartar (contado em flow_stats_t.refused, o logger mostra; um
+         * print por recusa só aumentaria a carga). Com crédito, envia sem
+         * bloquear; fila cheia = descarte */
+        if (!flow_acquire(&g_pipe_flow, 0)) {
+            health_set(STAGE_GEN, xTaskGetTickCount(), true);
+        } else if (pipe_send(&item, 0)) {
+            health_set(STAGE_GEN, xTaskGetTickCount(), true);
+            g_metrics.produced++;
             PRINTF("[GERADOR] Valor %d enfileirado com sucesso.\n", value);
             value++;
         } else {
-            /* Descarta, mas segue operando */
+            /* Descarta, mas segue operando (o crédito volta: nada em voo) */
+            flow_grant(&g_pipe_flow, 1);
+            g_metrics.dropped++;
             PRINTF("[GERADOR] Fila cheia – valor %d descartado.\n", value);
             value++; // segue sequência mesmo descartando
         }
 
         /* Checagem de stack em runtime */
         UBaseType_t watermark = uxTaskGetStackHighWaterMark(NULL);
+        metrics_stack_mark(STAGE_GEN, watermark);
         if (watermark < 100) {
             PRINTF("[GERADOR] Atenção: pouca pilha restante (%u words).\n", (unsigned)watermark);
         }
 
-        esp_task_wdt_reset();
-        vTaskDelay(STALL_TICKS(GEN_PERIOD_MS));
+        wdt_beat(STAGE_GEN);
+        int64_t wait_us = traffic.next_us - esp_timer_get_time();
+        swdt_expect(STAGE_GEN, wait_us > 0 ? (uint32_t)wait_us : 0);
+        traffic_set_slowdown(&traffic, shed_gen_slow_shift());
+        uint32_t due = (uint32_t)traffic.next_us;
+        traffic_wait_next(&traffic, GEN_MAX_SLEEP_MS, gen_slice_beat);
+        metrics_on_release(due, metrics_now_us());
     }
+
+    PRINTF("[GERADOR] Saindo a pedido do supervisor.\n");
+    stage_exit(STAGE_GEN, &g_task_gen);
 }
 
 /* ==========================
@@ -105,36 +154,75 @@ static void task_generator(void *pv) {
  *  Recebe da fila; usa malloc/free temporário por item; reage a timeouts.
  * ========================== */
 static void task_receiver(void *pv) {
-    esp_task_wdt_add(NULL);
+    wdt_subscribe(STAGE_RX);
 
     int timeouts = 0;
+    rx_rto_t rto;
+    rx_rto_init(&rto);
 
-    for (;;) {
-        int rx_val = 0;
-        if (xQueueReceive(g_queue, &rx_val, STALL_TICKS(RX_TIMEOUT_MS)) == pdTRUE) {
+    while (!s_stop_req[STAGE_RX]) {
+        if (fault_take(FAULT_RX_HANG)) {
+            fault_hang();
+        }
+
+        /* Prazo: espera da fila + folga de processamento */
+        swdt_expect(STAGE_RX, rx_rto_ms(&rto) * 1000 + RX_PROC_DELAY_MS * 1000);
+
+        pipe_item_t rx_val;
+        bool got;
+        if (fault_queue_stalled()) {
+            /* Canal travado (injeção): nada chega até o reset da fila */
+            vTaskDelay(rx_rto_ticks(&rto));
+            got = false;
+        } else {
+            got = pipe_receive(&rx_val, rx_rto_ticks(&rto));
+        }
+
+        if (got) {
             /* Recebeu: zera contadores de falha e usa memória dinâmica */
             timeouts = 0;
-            g_hb_rx = xTaskGetTickCount();
-            g_flag_rx_ok = true;
+            rx_rto_on_arrival(&rto, metrics_now_us());
+            health_set(STAGE_RX, xTaskGetTickCount(), true);
 
-            int *tmp = (int*) malloc(sizeof(int));
+            int *tmp = fault_take(FAULT_MALLOC_FAIL) ? NULL : (int*) malloc(sizeof(int));
             if (!tmp) {
                 PRINTF("[RX] ERRO CRÍTICO: malloc falhou – sem memória.\n");
+                fault_note(FAULT_EV_RX_MALLOC_FAIL);
                 /* Sinaliza problema e pede reinício do sistema via supervisor */
-                g_flag_rx_ok = false;
+                health_set_ok(STAGE_RX, false);
                 break; // deixa o supervisor recriar
             }
-            *tmp = rx_val;
-
+            *tmp = rx_val.value;
+
+#if APP_SINKS && !APP_BUS
+            /* "Transmissão": entrega aos sinks (console, flash, rede) e segue */
+            sink_publish(&rx_val);
+#elif APP_SINKS
+            /* "Transmissão": os sinks assinam o barramento (publicação abaixo) */
+#else
             /* \"Transmissão\": exibe no terminal */
             PRINTF("[RX] Transmitindo valor: %d\n", *tmp);
+#endif
 
             free(tmp);
+#if APP_BUS
+            /* Publica sem cópia por assinante: o registro entra uma vez no buffer */
+            bus_msg_t *msg = bus_alloc(0);
+            if (msg) {
+                memcpy(msg->payload, &rx_val, sizeof(rx_val));
+                bus_publish(msg, BUS_TOPIC_RECORD);
+            }
+#endif
+            metrics_on_consumed(&rx_val);
+            flow_grant(&g_pipe_flow, 1);
+            fault_on_consumed();
 
         } else {
             /* TIMEOUT – comportamento escalonado */
             timeouts++;
-            PRINTF("[RX] Timeout de %d ms na fila (contagem=%d).\n", RX_TIMEOUT_MS, timeouts);
+            rx_rto_on_timeout(&rto);
+            fault_note(FAULT_EV_RX_TIMEOUT);
+            PRINTF("[RX] Timeout de %u ms na fila (contagem=%d).\n", (unsigned)rx_rto_ms(&rto), timeouts);
 
             if (timeouts == RX_WARN_THRESHOLD) {
                 PRINTF("[RX] Aviso: ausência de dados – checando conexões.\n");
@@ -142,120 +230,384 @@ static void task_receiver(void *pv) {
                 PRINTF("[RX] Recuperação leve: limpando estados locais.\n");
                 /* (coloque aqui limpezas de buffers/caches se houver) */
             } else if (timeouts == RX_RECOVER_RESET_Q) {
+#if APP_RX_PRESERVE_ON_RECOVERY
+                pipe_recover_t rec;
+                pipe_recover(&rec);
+                g_metrics.recoveries++;
+                g_metrics.recovery_lost += rec.lost;
+                PRINTF("[RX] Recuperação moderada: fila reiniciada (%u itens preservados, %u perdidos).\n",
+                       (unsigned)rec.reinjected, (unsigned)rec.lost);
+#else
                 PRINTF("[RX] Recuperação moderada: resetando a fila.\n");
-                xQueueReset(g_queue);
+                pipe_reset();
+#endif
+                flow_resync(&g_pipe_flow, pipe_waiting());
+                fault_on_queue_reset();
             } else if (timeouts >= RX_FAIL_THRESHOLD) {
                 PRINTF("[RX] Falha persistente: encerrando tarefa para recriação pelo supervisor.\n");
-                g_flag_rx_ok = false;
+                health_set_ok(STAGE_RX, false);
                 break; // sai do loop para o supervisor detectar e recriar
             }
         }
 
         /* Telemetria de heap */
-        size_t free_heap = xPortGetFreeHeapSize();
-        size_t min_heap  = xPortGetMinimumEverFreeHeapSize();
+        size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        size_t min_heap  = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
         if (free_heap < (20 * 1024)) {
             PRINTF("[RX] Pouca memória livre: %u bytes (mínimo histórico %u).\n",
                    (unsigned)free_heap, (unsigned)min_heap);
         }
 
-        esp_task_wdt_reset();
+        metrics_stack_mark(STAGE_RX, uxTaskGetStackHighWaterMark(NULL));
+        wdt_beat(STAGE_RX);
         /* Pequena folga para simular processamento */
-        vTaskDelay(pdMS_TO_TICKS(50));
+        vTaskDelay(pdMS_TO_TICKS(RX_PROC_DELAY_MS));
     }
 
     PRINTF("[RX] Tarefa será finalizada para permitir recriação.\n");
-    vTaskDelete(NULL);
+    stage_exit(STAGE_RX, &g_task_rx);
 }
 
 /* ==========================
  *  MÓDULO 3 – Supervisão
  *  Monitora heartbeats, flags e WDT. Recria tarefas quando necessário e
- *  reporta status periodicamente.
+ *  reporta status periodicamente. Roda como tarefa própria ou, com
+ *  APP_SERVICE_TIMERS, como job periódico da tarefa de serviço (svc.h).
  * ========================== */
-static void task_supervisor(void *pv) {
-    esp_task_wdt_add(NULL);
-
-    int rx_restarts = 0;
+static int s_rx_restarts = 0;
+
+static void restart_generator(void) {
+    PRINTF("[SUP] Detetado GERADOR inativo – reiniciando tarefa.\n");
+    fault_note(FAULT_EV_SUP_GEN_RESTART);
+    if (g_task_gen) {
+        vTaskDelete(g_task_gen);   // só com heartbeat perdido: não sai sozinha
+        g_task_gen = NULL;
+    }
+    s_stop_req[STAGE_GEN] = false;   // antes de criar: a nova tarefa lê no início
+    xTaskCreatePinnedToCore(task_generator, "task_generator",
+                            GEN_STACK_WORDS, NULL, GEN_TASK_PRIO, &g_task_gen, APP_PIPE_CORE);
+    g_metrics.restarts[STAGE_GEN]++;
+    health_set(STAGE_GEN, xTaskGetTickCount(), false); // ok será setado pela própria tarefa
+}
 
-    for (;;) {
-        vTaskDelay(STALL_TICKS(SUP_PERIOD_MS));
-        TickType_t now = xTaskGetTickCount();
-        g_hb_sup = now;
-
-        /* Status/flags na tela */
-        PRINTF("[SUP] Status – GEN:%s (hb=%u) | RX:%s (hb=%u)\n",
-               g_flag_gen_ok ? "OK" : "ERRO",
-               (unsigned)g_hb_gen,
-               g_flag_rx_ok  ? "OK" : "ERRO",
-               (unsigned)g_hb_rx);
-
-        /* GEN parado? (sem heartbeat recente) – recria */
-        if ((now - g_hb_gen) > STALL_TICKS(3 * SUP_PERIOD_MS)) {
-            PRINTF("[SUP] Detetado GERADOR inativo – reiniciando tarefa.\n");
-            if (g_task_gen) {
-                vTaskDelete(g_task_gen);
-                g_task_gen = NULL;
-            }
-            xTaskCreatePinnedToCore(task_generator, "task_generator",
-                                    GEN_STACK_WORDS, NULL, GEN_TASK_PRIO, &g_task_gen, 1);
-            g_hb_gen = xTaskGetTickCount();
-            g_flag_gen_ok = false; // será setado pela própria tarefa
+static void restart_receiver(void) {
+    PRINTF("[SUP] Detetada RX inativa – recriando tarefa.\n");
+    fault_note(FAULT_EV_SUP_RX_RESTART);
+    if (g_task_rx) {
+        pipe_detach_receiver();
+        vTaskDelete(g_task_rx);   // só com heartbeat perdido: não sai sozinha
+        g_task_rx = NULL;
+    }
+    s_stop_req[STAGE_RX] = false;
+    /* Item que a RX antiga tinha em mãos não devolveu crédito */
+    flow_resync(&g_pipe_flow, pipe_waiting());
+    xTaskCreatePinnedToCore(task_receiver, "task_receiver",
+                            RX_STACK_WORDS, NULL, RX_TASK_PRIO, &g_task_rx, APP_PIPE_CORE);
+    s_rx_restarts++;
+    g_metrics.restarts[STAGE_RX]++;
+    health_set(STAGE_RX, xTaskGetTickCount(), false); // ok será setado pela própria tarefa
+
+    /* Heurística: muitas recriações + pouca memória => degrada um degrau */
+    if (s_rx_restarts >= 3) {
+        size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        if (free_heap < (16 * 1024)) {
+            PRINTF("[SUP] Memória crítica após várias recriações (%u bytes). Degradando serviço.\n",
+                   (unsigned)free_heap);
+            fault_note(FAULT_EV_HEAP_CRITICAL);
+            shed_escalate();
         }
+    }
+}
 
-        /* RX ausente ou sem batidas – recria */
-        if (g_task_rx == NULL || (now - g_hb_rx) > STALL_TICKS(5 * SUP_PERIOD_MS)) {
-            PRINTF("[SUP] Detetada RX inativa – recriando tarefa.\n");
-            if (g_task_rx) {
-                vTaskDelete(g_task_rx);
-                g_task_rx = NULL;
-            }
-            xTaskCreatePinnedToCore(task_receiver, "task_receiver",
-                                    RX_STACK_WORDS, NULL, RX_TASK_PRIO, &g_task_rx, 1);
-            rx_restarts++;
-            g_hb_rx = xTaskGetTickCount();
-            g_flag_rx_ok = false; // será setado pela própria tarefa
-
-            /* Heurística: muitas recriações + pouca memória => reiniciar chip */
-            if (rx_restarts >= 3) {
-                size_t free_heap = xPortGetFreeHeapSize();
-                if (free_heap < (16 * 1024)) {
-                    PRINTF("[SUP] Memória crítica após várias recriações (%u bytes). Reiniciando dispositivo...\n",
-                           (unsigned)free_heap);
-                    esp_restart();
-                }
-            }
-        }
+/* RESTART do swdt: com a tarefa viva só pede a saída; quem recria é o
+ * aviso de saída (SUP_EXITED_BIT) ou o tick, o que vier primeiro. Um aviso
+ * que chega depois do tick encontra a tarefa nova e é ignorado */
+static void supervisor_stage_bits(uint32_t bits, stage_id_t stage, TaskHandle_t handle,
+                                  void (*restart)(void)) {
+    if (handle == NULL && (bits & (SUP_EXITED_BIT(stage) | SWDT_RESTART_BIT(stage)))) {
+        restart();
+    } else if (handle != NULL && (bits & SWDT_RESTART_BIT(stage)) && !s_stop_req[stage]) {
+        s_stop_req[stage] = true;
+        PRINTF("[SUP] Pedindo saída do estágio %d para recriação.\n", (int)stage);
+    }
+}
 
-        /* Telemetria de heap geral */
-        size_t free_heap = xPortGetFreeHeapSize();
-        size_t min_heap  = xPortGetMinimumEverFreeHeapSize();
-        PRINTF("[SUP] Heap livre=%u bytes (mínimo histórico %u).\n",
-               (unsigned)free_heap, (unsigned)min_heap);
-        if (min_heap < (8 * 1024)) {
-            PRINTF("[SUP] Heap mínimo crítico – reiniciando dispositivo...\n");
-            esp_restart();
-        }
+/* Bits do swdt (e avisos de saída): só avisos e recriações. A escada de degradação conta
+ * rodadas, então fica restrita ao tick periódico (supervisor_tick) */
+static void supervisor_on_swdt(uint32_t swdt_bits) {
+    if (swdt_bits & SWDT_NOTIFY_BIT(STAGE_GEN)) {
+        PRINTF("[SUP] Watchdog de software: GERADOR atrasado.\n");
+    }
+    if (swdt_bits & SWDT_NOTIFY_BIT(STAGE_RX)) {
+        PRINTF("[SUP] Watchdog de software: RX atrasada.\n");
+    }
+    supervisor_stage_bits(swdt_bits, STAGE_GEN, g_task_gen, restart_generator);
+    supervisor_stage_bits(swdt_bits, STAGE_RX, g_task_rx, restart_receiver);
+}
+
+/* Uma rodada periódica de supervisão (a cada SUP_PERIOD_MS) */
+static void supervisor_tick(void) {
+    TickType_t now = xTaskGetTickCount();
+    health_set(STAGE_SUP, now, true);
+    health_data_t hs;
+    health_snapshot(&hs);
+
+    /* Status/flags na tela */
+    PRINTF("[SUP] Status – GEN:%s (hb=%u) | RX:%s (hb=%u)\n",
+           hs.ok[STAGE_GEN] ? "OK" : "ERRO",
+           (unsigned)hs.hb[STAGE_GEN],
+           hs.ok[STAGE_RX]  ? "OK" : "ERRO",
+           (unsigned)hs.hb[STAGE_RX]);
+
+    /* GEN parado? (sem heartbeat recente) – recria */
+    if (g_task_gen == NULL || (now - hs.hb[STAGE_GEN]) > STALL_TICKS(3 * SUP_PERIOD_MS)) {
+        restart_generator();
+    }
 
-        esp_task_wdt_reset();
+    /* RX ausente ou sem batidas – recria */
+    if (g_task_rx == NULL || (now - hs.hb[STAGE_RX]) > STALL_TICKS(5 * SUP_PERIOD_MS)) {
+        restart_receiver();
+    }
+
+    /* Telemetria de heap geral */
+    size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    size_t min_heap  = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    PRINTF("[SUP] Heap livre=%u bytes (mínimo histórico %u).\n",
+           (unsigned)free_heap, (unsigned)min_heap);
+
+    /* Degradação gradual: reinício só no último degrau */
+    shed_level_t prev_level = g_shed_level;
+    shed_level_t level = shed_update(free_heap);
+    if (level != prev_level) {
+        PRINTF("[SUP] Degradação: %s -> %s (heap livre %u bytes).\n",
+               shed_level_name(prev_level), shed_level_name(level), (unsigned)free_heap);
+        if (prev_level == SHED_NORMAL) {
+            fault_note(FAULT_EV_HEAP_CRITICAL);
+        }
     }
+    if (level == SHED_REBOOT) {
+        PRINTF("[SUP] Heap crítico mesmo degradado – reiniciando dispositivo...\n");
+        esp_restart();
+    }
+#if APP_BUS
+    bus_msg_t *msg = bus_alloc(0);
+    if (msg) {
+        bus_status_t st = {
+            .free_heap = (uint32_t)free_heap,
+            .restarts = g_metrics.restarts[STAGE_GEN] + g_metrics.restarts[STAGE_RX],
+            .shed_level = (uint8_t)level,
+        };
+        memcpy(msg->payload, &st, sizeof(st));
+        bus_publish(msg, BUS_TOPIC_STATUS);
+    }
+#endif
+#if !APP_SERVICE_TIMERS
+    /* Logger encerra sozinho quando desligado (não é apagado no meio de
+     * um printf); aqui só é recriado quando a memória volta */
+    if (shed_logger_enabled() && g_task_log == NULL) {
+        xTaskCreatePinnedToCore(task_logger, "task_logger", LOG_STACK_WORDS,
+                                NULL, LOG_TASK_PRIO, &g_task_log, APP_PIPE_CORE);
+    }
+#endif
+
+    metrics_stack_mark(STAGE_SUP, uxTaskGetStackHighWaterMark(NULL));
+    swdt_expect(STAGE_SUP, SUP_PERIOD_MS * 1000);
+    wdt_beat(STAGE_SUP);
 }
 
 /* ==========================
  *  LOG PERIÓDICO (opcional)
  * ========================== */
-static void task_logger(void *pv) {
+static void logger_print(void) {
+    health_data_t hs;
+    health_snapshot(&hs);
+    PRINTF("[LOG] HB_GEN=%u | HB_RX=%u | HB_SUP=%u\n",
+           (unsigned)hs.hb[STAGE_GEN], (unsigned)hs.hb[STAGE_RX], (unsigned)hs.hb[STAGE_SUP]);
+    metrics_print_timing("[LOG]");
+#if APP_SINKS
+    static uint32_t prev_written[SINK_MAX];
+    for (int i = 0; i < sink_count(); i++) {
+        sink_stats_t ss;
+        uint32_t queued;
+        sink_get_stats(i, &ss, &queued);
+        PRINTF("[LOG] %s: %u itens/s | escritos=%u descartados=%u falhas=%u fila=%u | lag=%u ms (máx %u ms)\n",
+               sink_name(i), (unsigned)((ss.written - prev_written[i]) * 1000 / LOG_PERIOD_MS),
+               (unsigned)ss.written, (unsigned)ss.dropped, (unsigned)ss.failed, (unsigned)queued,
+               (unsigned)(ss.lag_us / 1000), (unsigned)(ss.lag_max_us / 1000));
+        prev_written[i] = ss.written;
+    }
+#endif
+#if APP_BUS
+    PRINTF("[LOG] Bus: pool livre=%u (mín %u) | falhas de alocação=%u\n",
+           (unsigned)bus_pool_free(), (unsigned)bus_pool_min_free(), (unsigned)bus_alloc_failures());
+    for (int i = 0; i < bus_sub_count(); i++) {
+        const bus_sub_t *sub = bus_sub_get(i);
+        PRINTF("[LOG] Bus %s: entregues=%u descartados=%u | lag=%u us (máx %u us)\n",
+               sub->name, (unsigned)sub->delivered, (unsigned)sub->dropped,
+               (unsigned)sub->lag_us, (unsigned)sub->lag_max_us);
+    }
+#endif
+#if APP_FLOW_CONTROL
+    flow_stats_t fs;
+    int32_t credits;
+    flow_get_stats(&g_pipe_flow, &fs, &credits);
+    PRINTF("[LOG] Fluxo: créditos=%d | pausas=%u (%u ms) | adiados=%u\n",
+           (int)credits, (unsigned)fs.throttles, (unsigned)(fs.throttled_us / 1000), (unsigned)fs.refused);
+#endif
+    metrics_stack_mark(STAGE_LOG, uxTaskGetStackHighWaterMark(NULL));
+    swdt_expect(STAGE_LOG, LOG_PERIOD_MS * 1000);
+}
+
+#if APP_SERVICE_TIMERS
+
+/* Jobs da tarefa de serviço */
+static void supervisor_job(uint32_t arg) {
+    static bool subscribed = false;
+    if (!subscribed) {
+        wdt_subscribe(STAGE_SUP);   // registra a tarefa de serviço, que executa o job
+        subscribed = true;
+    }
+    supervisor_tick();
+}
+
+static void supervisor_swdt_job(uint32_t swdt_bits) {
+    supervisor_on_swdt(swdt_bits);
+}
+
+static void logger_job(uint32_t arg) {
+    if (shed_logger_enabled()) {
+        logger_print();
+    } else {
+        swdt_disarm(STAGE_LOG);   // desligado pela degradação de memória
+    }
+}
+
+/* Bits do swdt: job à parte, sem contar como rodada periódica */
+static void sup_notify(uint32_t bits) {
+    svc_defer(supervisor_swdt_job, bits);
+}
+
+#else
+
+static void task_supervisor(void *pv) {
+    wdt_subscribe(STAGE_SUP);
+
+    const TickType_t period = STALL_TICKS(SUP_PERIOD_MS);
+    TickType_t last = xTaskGetTickCount();
     for (;;) {
-        PRINTF("[LOG] HB_GEN=%u | HB_RX=%u | HB_SUP=%u\n",
-               (unsigned)g_hb_gen, (unsigned)g_hb_rx, (unsigned)g_hb_sup);
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        /* Dorme até o próximo tick ou até o watchdog de software acusar um
+         * estágio; a notificação não adianta nem estica o período */
+        TickType_t elapsed = xTaskGetTickCount() - last;
+        uint32_t swdt_bits = 0;
+        if (xTaskNotifyWait(0, UINT32_MAX, &swdt_bits,
+                            elapsed < period ? period - elapsed : 0) == pdTRUE) {
+            supervisor_on_swdt(swdt_bits);
+        }
+
+        if (xTaskGetTickCount() - last >= period) {
+            last = xTaskGetTickCount();
+            supervisor_tick();
+        }
+    }
+}
+
+static void task_logger(void *pv) {
+    while (shed_logger_enabled()) {
+        logger_print();
+        vTaskDelay(pdMS_TO_TICKS(LOG_PERIOD_MS));
     }
+
+    PRINTF("[LOG] Desligado pela degradação de memória.\n");
+    swdt_disarm(STAGE_LOG);
+    g_task_log = NULL;
+    vTaskDelete(NULL);
+}
+
+static void sup_notify(uint32_t bits) {
+    xTaskNotify(g_task_sup, bits, eSetBits);
 }
 
+#endif // APP_SERVICE_TIMERS
+
 /* ==========================
  *  app_main – inicialização, WDT, fila e tarefas
  * ========================== */
 void app_main(void) {
+#if APP_VIRTUAL_TIME
+    vclock_start();
+#endif
+
+#if APP_MODE_IPC_BENCH
+    ipc_bench_run();
+    return;
+#endif
+
+#if APP_MODE_ICOUNT_BENCH
+    /* Regiões quentes medidas isoladamente: só o canal é necessário */
+    if (!pipe_init()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar fila – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+    icount_bench_run();
+    return;
+#endif
+
+#if APP_MODE_STRESS
+    /* Pipeline de saturação: sem supervisor/log e sem WDT por tarefa */
+    if (!pipe_init()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar fila – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+    stress_run();
+    return;
+#endif
+
+#if APP_MODE_PARALLEL
+    /* Processamento no pool de workers: sem pipeline, supervisor nem WDT por tarefa */
+    parallel_run();
+    return;
+#endif
+
+#if APP_MODE_SHARDED
+    /* K pipelines por chave: sem supervisor e sem WDT por tarefa */
+    shard_pipeline_run();
+    return;
+#endif
+
+#if APP_MODE_FAIR
+    /* Vários fluxos numa RX com DRR: sem supervisor e sem WDT por tarefa */
+    fair_pipeline_run();
+    return;
+#endif
+
+#if APP_MODE_LANES
+    /* Faixa urgente + bulk: sem supervisor e sem WDT por tarefa */
+    lane_pipeline_run();
+    return;
+#endif
+
+#if APP_MODE_COROUTINE
+    /* Estágios como corrotinas numa tarefa: sem supervisor e sem WDT por tarefa */
+    metrics_init();
+    if (!pipe_init()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar fila – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+    coro_pipeline_start();
+    return;
+#endif
+
+#if APP_MODE_CYCLIC
+    /* Fonte/processamento/transmissão pela tabela de quadros, sem preempção */
+    metrics_init();
+    if (!pipe_init()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar fila – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+    cyclic_start();
+    return;
+#endif
+
     PRINTF("[BOOT] Iniciando sistema multitarefa FreeRTOS com WDT.\n");
 
     /* Inicializa o Task Watchdog (timeout e reset em pânico habilitado) */
@@ -265,34 +617,77 @@ void app_main(void) {
         .trigger_panic = true,
     };
     esp_task_wdt_init(&wdt_cfg);
+    wdt_proxy_start();
+
+    metrics_init();
+    flow_init(&g_pipe_flow, FLOW_HIGH_WM, FLOW_LOW_WM);
 
-    /* Cria fila */
-    g_queue = xQueueCreate(QUEUE_LEN, QUEUE_ITEM_SIZE);
-    if (!g_queue) {
+    /* Cria fila (canal tipado, armazenamento estático) */
+    if (!pipe_init()) {
         PRINTF("[BOOT] ERRO: Falha ao criar fila – reiniciando dispositivo.\n");
         esp_restart();
     }
 
+#if APP_BUS
+    if (!bus_init() || !bus_subs_start()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar o barramento – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+#endif
+
+#if APP_SINKS
+    sinks_register_builtin();
+    if (!sink_start()) {
+        PRINTF("[BOOT] ERRO: Falha ao criar sinks – reiniciando dispositivo.\n");
+        esp_restart();
+    }
+#endif
+
+    /* Ações do watchdog de software por estágio */
+    swdt_configure(STAGE_GEN, SWDT_ACTIONS_GEN);
+    swdt_configure(STAGE_RX,  SWDT_ACTIONS_RX);
+    swdt_configure(STAGE_SUP, SWDT_ACTIONS_SUP);
+    swdt_configure(STAGE_LOG, SWDT_ACTIONS_LOG);
+
     /* Cria tarefas principais */
     BaseType_t ok = pdPASS;
 
     ok &= xTaskCreatePinnedToCore(task_generator, "task_generator", GEN_STACK_WORDS,
-                                  NULL, GEN_TASK_PRIO, &g_task_gen, 1) == pdPASS;
+                                  NULL, GEN_TASK_PRIO, &g_task_gen, APP_PIPE_CORE) == pdPASS;
 
     ok &= xTaskCreatePinnedToCore(task_receiver,  "task_receiver",  RX_STACK_WORDS,
-                                  NULL, RX_TASK_PRIO,  &g_task_rx,  1) == pdPASS;
-
+                                  NULL, RX_TASK_PRIO,  &g_task_rx,  APP_PIPE_CORE) == pdPASS;
+
+#if APP_SERVICE_TIMERS
+    /* Supervisor e log como timers + uma tarefa de serviço compartilhada */
+    ok &= svc_start();
+    ok &= svc_every("sup_timer", SUP_PERIOD_MS, supervisor_job, 0);
+    ok &= svc_every("log_timer", LOG_PERIOD_MS, logger_job, 0);
+#else
     ok &= xTaskCreatePinnedToCore(task_supervisor, "task_supervisor", SUP_STACK_WORDS,
-                                  NULL, SUP_TASK_PRIO, &g_task_sup, 1) == pdPASS;
+                                  NULL, SUP_TASK_PRIO, &g_task_sup, APP_PIPE_CORE) == pdPASS;
 
     /* Log auxiliar (opcional) */
     xTaskCreatePinnedToCore(task_logger, "task_logger", LOG_STACK_WORDS,
-                            NULL, LOG_TASK_PRIO, &g_task_log, 1);
+                            NULL, LOG_TASK_PRIO, &g_task_log, APP_PIPE_CORE);
+#endif
 
     if (!ok) {
         PRINTF("[BOOT] ERRO: Falha na criação de tarefas – reiniciando dispositivo.\n");
         esp_restart();
     }
 
+    swdt_set_notify(sup_notify);
+    if (!swdt_start()) {
+        PRINTF("[BOOT] Aviso: watchdog de software indisponível.\n");
+    }
+
     PRINTF("[BOOT] Tarefas criadas com sucesso. Sistema em execução.\n");
+
+#if APP_MODE_SOAK
+    soak_start();
+#endif
+#if APP_FAULT_INJECTION
+    fault_init();
+#endif
 }
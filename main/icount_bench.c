@@ -0,0 +1,118 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_cpu.h"
+#include "esp_task_wdt.h"
+#include "esp_heap_caps.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "icount_bench.h"
+
+/* ==========================
+ *  Regiões medidas
+ *  Cada função executa `iters` vezes o trecho equivalente ao da pipeline.
+ * ========================== */
+typedef struct {
+    const char *name;
+    uint32_t iters;
+    void (*fn)(uint32_t iters);
+} icount_region_t;
+
+/* Evita que o compilador descarte resultados das regiões */
+static volatile uint32_t s_sink;
+
+static void region_queue_send_recv(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        pipe_item_t v = { .value = (int32_t)i };
+        pipe_send(&v, 0);
+        pipe_receive(&v, 0);
+        s_sink += (uint32_t)v.value;
+    }
+}
+
+static void region_malloc_free(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        int *tmp = (int*) malloc(sizeof(int));
+        if (tmp) {
+            *tmp = (int)i;
+            s_sink += (uint32_t)*tmp;
+            free(tmp);
+        }
+    }
+}
+
+static void region_format(uint32_t iters) {
+    char line[96];
+    for (uint32_t i = 0; i < iters; i++) {
+        s_sink += (uint32_t)snprintf(line, sizeof(line), STUDENT_PREFIX "[RX] Transmitindo valor: %d\n", (int)i);
+    }
+}
+
+static void region_log(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        PRINTF("[RX] Transmitindo valor: %d\n", (int)i);
+    }
+    fflush(stdout);
+}
+
+static void region_heap_telemetry(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        s_sink += heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        s_sink += heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    }
+}
+
+static void region_wdt_reset(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        esp_task_wdt_reset();
+    }
+}
+
+static void region_tick_count(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        s_sink += xTaskGetTickCount();
+    }
+}
+
+static const icount_region_t k_regions[] = {
+    { "queue_send_recv",  1000, region_queue_send_recv },
+    { "malloc_free",      1000, region_malloc_free     },
+    { "format",           1000, region_format          },
+    { "log_printf",         16, region_log             },
+    { "heap_telemetry",   1000, region_heap_telemetry  },
+    { "wdt_reset",        1000, region_wdt_reset       },
+    { "tick_count",       1000, region_tick_count      },
+};
+
+void icount_bench_run(void) {
+    PRINTF("[ICOUNT] Iniciando benchmark por contagem de instruções.\n");
+    fflush(stdout);
+
+    /* wdt_reset precisa da tarefa inscrita no Task WDT */
+    esp_task_wdt_add(NULL);
+
+    for (size_t r = 0; r < sizeof(k_regions) / sizeof(k_regions[0]); r++) {
+        const icount_region_t *reg = &k_regions[r];
+
+        reg->fn(1);  // aquecimento: primeira alocação, lazy init do stdio etc.
+
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        reg->fn(reg->iters);
+        uint32_t cycles = esp_cpu_get_cycle_count() - c0;
+
+        PRINTF("[ICOUNT] {\"region\":\"%s\",\"iters\":%" PRIu32 ",\"cycles\":%" PRIu32
+               ",\"per_iter\":%" PRIu32 "}\n",
+               reg->name, reg->iters, cycles, cycles / reg->iters);
+        fflush(stdout);
+    }
+
+    esp_task_wdt_delete(NULL);
+    PRINTF("[ICOUNT] fim\n");
+    fflush(stdout);
+}
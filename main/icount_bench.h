@@ -0,0 +1,23 @@
+#pragma once
+
+/* ==========================
+ *  Benchmark por contagem de instruções (modo APP_MODE_ICOUNT_BENCH)
+ *  Executa os caminhos quentes da pipeline (fila, log, alocação,
+ *  formatação, telemetria de heap, WDT) e lê o CCOUNT em volta de cada
+ *  região. Sob QEMU com -icount o CCOUNT é derivado do número de instruções
+ *  executadas, então a contagem é exata e reprodutível entre execuções.
+ *
+ *  Saída: uma linha "[ICOUNT] {...}" por região e "[ICOUNT] fim" no final.
+ *  O script icount_bench.py (raiz do projeto) roda o QEMU, coleta as linhas
+ *  e grava/compara o arquivo de resultados.
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void icount_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
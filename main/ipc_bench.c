@@ -0,0 +1,371 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/message_buffer.h"
+
+#include "esp_timer.h"
+#include "unity.h"
+
+#include "app_config.h"
+#include "ipc_bench.h"
+
+#if APP_HAS_RINGBUF
+#include "freertos/ringbuf.h"
+#endif
+
+/* ==========================
+ *  PARÂMETROS DO BENCHMARK
+ * ========================== */
+#define BENCH_TASK_PRIO        5
+#define BENCH_STACK_WORDS      3072
+#define BENCH_STREAM_ITEMS     2000   // itens por rodada de vazão
+#define BENCH_PINGPONG_ITEMS   200    // itens por rodada de latência
+#define BENCH_MAX_ITEM_SIZE    128
+#define BENCH_STAMP_RING       64     // carimbos em voo (primitivas sem payload)
+#define BENCH_DRAIN_MS         100    // falhou um lado: espera o outro antes de apagá-lo
+/* Cabeçalho de tamanho por mensagem no message buffer: o kernel grava
+ * configMESSAGE_BUFFER_LENGTH_TYPE (size_t por padrão) – 8 bytes no linux */
+#define BENCH_MB_HEADER        sizeof(size_t)
+
+static const size_t k_sizes[]  = { 4, 32, BENCH_MAX_ITEM_SIZE };
+static const size_t k_depths[] = { 1, 8, 32 };
+
+/* O produtor fica no máximo `depth` itens à frente do consumidor */
+_Static_assert(BENCH_STAMP_RING > 32 + 1, "BENCH_STAMP_RING menor que a maior profundidade");
+
+/* Bits do event group (rendezvous dado/ack) */
+#define EG_DATA_BIT  (1u << 0)
+#define EG_ACK_BIT   (1u << 1)
+
+/* ==========================
+ *  Contexto de uma rodada e tabela de operações por primitiva
+ * ========================== */
+typedef struct bench_ctx bench_ctx_t;
+
+typedef struct {
+    const char *name;
+    bool sized;                                        // tem payload (varre tamanho)
+    bool deep;                                         // tem profundidade (varre k_depths)
+    bool (*create)(bench_ctx_t *c);
+    bool (*send)(bench_ctx_t *c, const uint8_t *buf);  // bloqueante até ser aceito
+    bool (*recv)(bench_ctx_t *c, uint8_t *buf);        // bloqueante até chegar
+    void (*destroy)(bench_ctx_t *c);
+} ipc_ops_t;
+
+struct bench_ctx {
+    const ipc_ops_t *ops;
+    size_t item_size;
+    size_t depth;
+    uint32_t count;
+    bool pingpong;
+
+    union {
+        QueueHandle_t q;
+        StreamBufferHandle_t sb;
+        MessageBufferHandle_t mb;
+#if APP_HAS_RINGBUF
+        RingbufHandle_t rb;
+#endif
+        SemaphoreHandle_t sem;
+        EventGroupHandle_t eg;
+    } h;
+    TaskHandle_t rx_task;
+    SemaphoreHandle_t ack;           // ping-pong: consumidor → produtor
+    SemaphoreHandle_t done;          // fim de cada lado
+    uint32_t stamps[BENCH_STAMP_RING]; // carimbos por sequência (primitivas sem payload)
+
+    /* Resultados (escritos pelo consumidor) */
+    uint32_t lat_min_us;
+    uint32_t lat_max_us;
+    uint64_t lat_sum_us;
+    int64_t  t_end;
+    volatile bool ok;                // qualquer lado pode zerar
+};
+
+static inline uint32_t now_us(void) { return (uint32_t)esp_timer_get_time(); }
+
+/* ---------- Fila ---------- */
+static bool q_create(bench_ctx_t *c) { return (c->h.q = xQueueCreate(c->depth, c->item_size)) != NULL; }
+static bool q_send(bench_ctx_t *c, const uint8_t *b) { return xQueueSend(c->h.q, b, portMAX_DELAY) == pdTRUE; }
+static bool q_recv(bench_ctx_t *c, uint8_t *b) { return xQueueReceive(c->h.q, b, portMAX_DELAY) == pdTRUE; }
+static void q_destroy(bench_ctx_t *c) { vQueueDelete(c->h.q); }
+
+/* ---------- Notificação de tarefa (valor de 32 bits) ---------- */
+static bool n_create(bench_ctx_t *c) { return true; }
+static bool n_send(bench_ctx_t *c, const uint8_t *b) {
+    while (xTaskNotify(c->rx_task, 1, eSetValueWithoutOverwrite) != pdPASS) {
+        taskYIELD();
+    }
+    return true;
+}
+static bool n_recv(bench_ctx_t *c, uint8_t *b) {
+    uint32_t v;
+    return xTaskNotifyWait(0, UINT32_MAX, &v, portMAX_DELAY) == pdTRUE;
+}
+static void n_destroy(bench_ctx_t *c) { }
+
+/* ---------- Stream buffer ---------- */
+static bool sb_create(bench_ctx_t *c) {
+    return (c->h.sb = xStreamBufferCreate(c->depth * c->item_size, c->item_size)) != NULL;
+}
+static bool sb_send(bench_ctx_t *c, const uint8_t *b) {
+    return xStreamBufferSend(c->h.sb, b, c->item_size, portMAX_DELAY) == c->item_size;
+}
+static bool sb_recv(bench_ctx_t *c, uint8_t *b) {
+    size_t got = 0;
+    while (got < c->item_size) {
+        got += xStreamBufferReceive(c->h.sb, b + got, c->item_size - got, portMAX_DELAY);
+    }
+    return true;
+}
+static void sb_destroy(bench_ctx_t *c) { vStreamBufferDelete(c->h.sb); }
+
+/* ---------- Message buffer (BENCH_MB_HEADER bytes de cabeçalho por mensagem) ---------- */
+static bool mb_create(bench_ctx_t *c) {
+    return (c->h.mb = xMessageBufferCreate(c->depth * (c->item_size + BENCH_MB_HEADER))) != NULL;
+}
+static bool mb_send(bench_ctx_t *c, const uint8_t *b) {
+    return xMessageBufferSend(c->h.mb, b, c->item_size, portMAX_DELAY) == c->item_size;
+}
+static bool mb_recv(bench_ctx_t *c, uint8_t *b) {
+    return xMessageBufferReceive(c->h.mb, b, c->item_size, portMAX_DELAY) == c->item_size;
+}
+static void mb_destroy(bench_ctx_t *c) { vMessageBufferDelete(c->h.mb); }
+
+#if APP_HAS_RINGBUF
+/* ---------- esp_ringbuf NOSPLIT (8 bytes de cabeçalho, payload alinhado a 4) ---------- */
+static bool rb_create(bench_ctx_t *c) {
+    size_t slot = ((c->item_size + 3) & ~(size_t)3) + 8;
+    return (c->h.rb = xRingbufferCreate(c->depth * slot, RINGBUF_TYPE_NOSPLIT)) != NULL;
+}
+static bool rb_send(bench_ctx_t *c, const uint8_t *b) {
+    return xRingbufferSend(c->h.rb, b, c->item_size, portMAX_DELAY) == pdTRUE;
+}
+static bool rb_recv(bench_ctx_t *c, uint8_t *b) {
+    size_t len = 0;
+    void *p = xRingbufferReceive(c->h.rb, &len, portMAX_DELAY);
+    if (!p) {
+        return false;
+    }
+    memcpy(b, p, len);
+    vRingbufferReturnItem(c->h.rb, p);
+    return true;
+}
+static void rb_destroy(bench_ctx_t *c) { vRingbufferDelete(c->h.rb); }
+#endif
+
+/* ---------- Semáforo contador ---------- */
+static bool s_create(bench_ctx_t *c) { return (c->h.sem = xSemaphoreCreateCounting(c->depth, 0)) != NULL; }
+static bool s_send(bench_ctx_t *c, const uint8_t *b) {
+    while (xSemaphoreGive(c->h.sem) != pdTRUE) {
+        taskYIELD();
+    }
+    return true;
+}
+static bool s_recv(bench_ctx_t *c, uint8_t *b) { return xSemaphoreTake(c->h.sem, portMAX_DELAY) == pdTRUE; }
+static void s_destroy(bench_ctx_t *c) { vSemaphoreDelete(c->h.sem); }
+
+/* ---------- Event group (rendezvous: DATA → ACK) ---------- */
+static bool eg_create(bench_ctx_t *c) { return (c->h.eg = xEventGroupCreate()) != NULL; }
+static bool eg_send(bench_ctx_t *c, const uint8_t *b) {
+    xEventGroupSetBits(c->h.eg, EG_DATA_BIT);
+    xEventGroupWaitBits(c->h.eg, EG_ACK_BIT, pdTRUE, pdTRUE, portMAX_DELAY);
+    return true;
+}
+static bool eg_recv(bench_ctx_t *c, uint8_t *b) {
+    xEventGroupWaitBits(c->h.eg, EG_DATA_BIT, pdTRUE, pdTRUE, portMAX_DELAY);
+    xEventGroupSetBits(c->h.eg, EG_ACK_BIT);
+    return true;
+}
+static void eg_destroy(bench_ctx_t *c) { vEventGroupDelete(c->h.eg); }
+
+static const ipc_ops_t k_queue   = { "queue",          true,  true,  q_create,  q_send,  q_recv,  q_destroy  };
+static const ipc_ops_t k_notify  = { "task_notify",    false, false, n_create,  n_send,  n_recv,  n_destroy  };
+static const ipc_ops_t k_stream  = { "stream_buffer",  true,  true,  sb_create, sb_send, sb_recv, sb_destroy };
+static const ipc_ops_t k_message = { "message_buffer", true,  true,  mb_create, mb_send, mb_recv, mb_destroy };
+#if APP_HAS_RINGBUF
+static const ipc_ops_t k_ringbuf = { "esp_ringbuf",    true,  true,  rb_create, rb_send, rb_recv, rb_destroy };
+#endif
+static const ipc_ops_t k_sem     = { "semaphore",      false, true,  s_create,  s_send,  s_recv,  s_destroy  };
+static const ipc_ops_t k_evgroup = { "event_group",    false, false, eg_create, eg_send, eg_recv, eg_destroy };
+
+/* ==========================
+ *  Tarefas produtora/consumidora
+ * ========================== */
+static void bench_producer(void *pv) {
+    bench_ctx_t *c = (bench_ctx_t *)pv;
+    uint8_t buf[BENCH_MAX_ITEM_SIZE] = { 0 };
+
+    for (uint32_t i = 0; i < c->count && c->ok; i++) {
+        uint32_t t = now_us();
+        if (c->ops->sized) {
+            memcpy(buf, &t, sizeof(t));
+        } else {
+            /* Slot i só é relido depois que o consumidor recebe o item i,
+             * e o produtor nunca passa `depth` itens à frente */
+            c->stamps[i % BENCH_STAMP_RING] = t;
+        }
+        if (!c->ops->send(c, buf)) {
+            c->ok = false;
+            break;
+        }
+        if (c->pingpong) {
+            xSemaphoreTake(c->ack, portMAX_DELAY);
+        }
+    }
+    xSemaphoreGive(c->done);
+    vTaskSuspend(NULL); // apagada pelo executor
+}
+
+static void bench_consumer(void *pv) {
+    bench_ctx_t *c = (bench_ctx_t *)pv;
+    uint8_t buf[BENCH_MAX_ITEM_SIZE];
+
+    for (uint32_t i = 0; i < c->count; i++) {
+        if (!c->ops->recv(c, buf)) {
+            c->ok = false;
+            break;
+        }
+        uint32_t t_rx = now_us();
+        uint32_t t_tx;
+        if (c->ops->sized) {
+            memcpy(&t_tx, buf, sizeof(t_tx));
+        } else {
+            t_tx = c->stamps[i % BENCH_STAMP_RING];
+        }
+        uint32_t lat = t_rx - t_tx;
+        if (lat < c->lat_min_us) c->lat_min_us = lat;
+        if (lat > c->lat_max_us) c->lat_max_us = lat;
+        c->lat_sum_us += lat;
+
+        if (c->pingpong) {
+            xSemaphoreGive(c->ack);
+        }
+    }
+    c->t_end = esp_timer_get_time();
+    xSemaphoreGive(c->done);
+    vTaskSuspend(NULL);
+}
+
+/* ==========================
+ *  Execução de uma rodada + emissão JSON
+ * ========================== */
+static bool bench_round(const ipc_ops_t *ops, size_t size, size_t depth,
+                        BaseType_t tx_core, BaseType_t rx_core, bool pingpong) {
+    bench_ctx_t c = {
+        .ops = ops, .item_size = size, .depth = depth,
+        .count = pingpong ? BENCH_PINGPONG_ITEMS : BENCH_STREAM_ITEMS,
+        .pingpong = pingpong,
+        .lat_min_us = UINT32_MAX, .ok = true,
+    };
+    TaskHandle_t tx = NULL;
+
+    c.ack  = xSemaphoreCreateBinary();
+    c.done = xSemaphoreCreateCounting(2, 0);
+    if (!c.ack || !c.done || !ops->create(&c)) {
+        return false;
+    }
+
+    /* Sem uma das tarefas, `done` nunca chegaria: desfaz e falha a rodada */
+    if (xTaskCreatePinnedToCore(bench_consumer, "bench_rx", BENCH_STACK_WORDS, &c,
+                                BENCH_TASK_PRIO, &c.rx_task, rx_core) != pdPASS) {
+        c.rx_task = NULL;
+        c.ok = false;
+    }
+    int64_t t_start = esp_timer_get_time();
+    if (c.ok && xTaskCreatePinnedToCore(bench_producer, "bench_tx", BENCH_STACK_WORDS, &c,
+                                        BENCH_TASK_PRIO, &tx, tx_core) != pdPASS) {
+        vTaskDelete(c.rx_task);   // bloqueada no recv, sem nada em voo
+        c.rx_task = NULL;
+        c.ok = false;
+    }
+    if (!c.ok) {
+        PRINTF("[BENCH] %s: falha ao criar as tarefas da rodada.\n", ops->name);
+        ops->destroy(&c);
+        vSemaphoreDelete(c.ack);
+        vSemaphoreDelete(c.done);
+        return false;
+    }
+
+    /* Um lado que falha sai e sinaliza; o outro pode estar bloqueado para
+     * sempre (recv/send/ack sem par): espera um pouco e apaga assim mesmo */
+    xSemaphoreTake(c.done, portMAX_DELAY);
+    if (xSemaphoreTake(c.done, c.ok ? portMAX_DELAY : pdMS_TO_TICKS(BENCH_DRAIN_MS)) != pdTRUE) {
+        PRINTF("[BENCH] %s: um lado falhou; o outro foi encerrado.\n", ops->name);
+    }
+
+    vTaskDelete(tx);
+    vTaskDelete(c.rx_task);
+    ops->destroy(&c);
+    vSemaphoreDelete(c.ack);
+    vSemaphoreDelete(c.done);
+
+    int64_t elapsed = c.t_end - t_start;
+    uint32_t ips = elapsed > 0 ? (uint32_t)((int64_t)c.count * 1000000 / elapsed) : 0;
+    uint32_t lat_avg_ns = (uint32_t)(c.lat_sum_us * 1000 / c.count);
+
+    PRINTF("[BENCH] {\"bench\":\"%s\",\"mode\":\"%s\",\"size\":%u,\"depth\":%u,"
+           "\"cores\":\"%s\",\"tx_core\":%d,\"rx_core\":%d,\"items\":%" PRIu32 ","
+           "\"throughput_ips\":%" PRIu32 ",\"lat_min_us\":%" PRIu32 ",\"lat_avg_ns\":%" PRIu32 ","
+           "\"lat_max_us\":%" PRIu32 ",\"ok\":%s}\n",
+           ops->name, pingpong ? "pingpong" : "stream",
+           (unsigned)(ops->sized ? size : 0), (unsigned)depth,
+           tx_core == rx_core ? "same" : "cross", (int)tx_core, (int)rx_core,
+           c.count, ips, c.lat_min_us, lat_avg_ns, c.lat_max_us,
+           c.ok ? "true" : "false");
+    return c.ok;
+}
+
+/* Vazão (stream) e latência (ping-pong), mesmo núcleo e entre núcleos */
+static void bench_matrix(const ipc_ops_t *ops) {
+    size_t n_sizes = ops->sized ? sizeof(k_sizes) / sizeof(k_sizes[0]) : 1;
+    size_t n_depths = ops->deep ? sizeof(k_depths) / sizeof(k_depths[0]) : 1;
+
+    for (size_t s = 0; s < n_sizes; s++) {
+        for (size_t d = 0; d < n_depths; d++) {
+            for (BaseType_t rx_core = 0; rx_core < APP_NUM_CORES; rx_core++) {
+                TEST_ASSERT_TRUE_MESSAGE(bench_round(ops, k_sizes[s], k_depths[d], 0, rx_core, false),
+                                         ops->name);
+                TEST_ASSERT_TRUE_MESSAGE(bench_round(ops, k_sizes[s], k_depths[d], 0, rx_core, true),
+                                         ops->name);
+            }
+        }
+    }
+}
+
+static void test_bench_queue(void)          { bench_matrix(&k_queue); }
+static void test_bench_task_notify(void)    { bench_matrix(&k_notify); }
+static void test_bench_stream_buffer(void)  { bench_matrix(&k_stream); }
+static void test_bench_message_buffer(void) { bench_matrix(&k_message); }
+#if APP_HAS_RINGBUF
+static void test_bench_ringbuf(void)        { bench_matrix(&k_ringbuf); }
+#endif
+static void test_bench_semaphore(void)      { bench_matrix(&k_sem); }
+static void test_bench_event_group(void)    { bench_matrix(&k_evgroup); }
+
+int ipc_bench_run(void) {
+    PRINTF("[BENCH] Iniciando microbenchmark IPC (%d núcleo(s)).\n", APP_NUM_CORES);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_queue);
+    RUN_TEST(test_bench_task_notify);
+    RUN_TEST(test_bench_stream_buffer);
+    RUN_TEST(test_bench_message_buffer);
+#if APP_HAS_RINGBUF
+    RUN_TEST(test_bench_ringbuf);
+#endif
+    RUN_TEST(test_bench_semaphore);
+    RUN_TEST(test_bench_event_group);
+    int failures = UNITY_END();
+
+    PRINTF("[BENCH] Fim do microbenchmark (%d falha(s)).\n", failures);
+    return failures;
+}
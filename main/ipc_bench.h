@@ -0,0 +1,23 @@
+#pragma once
+
+/* ==========================
+ *  Microbenchmark de primitivas IPC (modo APP_MODE_IPC_BENCH)
+ *  Mede vazão e latência de fila, notificação, stream/message buffer,
+ *  esp_ringbuf, semáforo e event group, no mesmo núcleo e entre núcleos.
+ *  Cada resultado sai como uma linha JSON: "[BENCH] {...}".
+ *
+ *  Uso: APP_MODE_IPC_BENCH=1 em app_config.h e então
+ *    idf.py qemu monitor                                  (ESP32 emulado)
+ *    idf.py --preview set-target linux && idf.py monitor  (host)
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Executa toda a suíte (bloqueante). Retorna o n° de casos com falha. */
+int ipc_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
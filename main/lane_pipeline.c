@@ -0,0 +1,110 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "lanes.h"
+#include "lane_pipeline.h"
+
+#if APP_MODE_LANES
+
+/* ==========================
+ *  PARÂMETROS
+ * ========================== */
+#define LANE_RX_PER_TICK     8        // capacidade da RX: itens por tick
+#define LANE_BULK_PER_TICK   10       // oferta bulk (acima da capacidade)
+#define LANE_ALARM_EVERY     7        // ticks entre rajadas de alarmes
+#define LANE_ALARM_BURST     3        // alarmes por rajada (1..3)
+#define LANE_REPORT_MS       2000
+
+static const char *const k_lane_name[LANE_COUNT] = { "urgente", "bulk" };
+
+/* ==========================
+ *  Fonte
+ * ========================== */
+static void task_lane_source(void *pv) {
+    int32_t seq = 0;
+    uint32_t tick = 0;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        uint32_t now = metrics_now_us();
+        for (int i = 0; i < LANE_BULK_PER_TICK; i++) {
+            pipe_item_t item = { .value = seq++, .t_enq_us = now };
+            lanes_send(LANE_BULK, &item, 0);
+        }
+        if (++tick % LANE_ALARM_EVERY == 0) {
+            int burst = 1 + (int)(tick / LANE_ALARM_EVERY) % LANE_ALARM_BURST;
+            for (int i = 0; i < burst; i++) {
+                pipe_item_t alarm = { .value = seq++, .t_enq_us = now };
+                lanes_send(LANE_URGENT, &alarm, 0);
+            }
+        }
+        xTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+/* ==========================
+ *  RX: até LANE_RX_PER_TICK itens por tick
+ * ========================== */
+static void task_lane_receiver(void *pv) {
+    TickType_t last_wake = xTaskGetTickCount();
+    for (;;) {
+        for (int n = 0; n < LANE_RX_PER_TICK; n++) {
+            pipe_item_t item;
+            lane_id_t lane;
+            if (!lanes_receive(&item, &lane, n == 0 ? portMAX_DELAY : 0)) {
+                break;
+            }
+        }
+        TickType_t now = xTaskGetTickCount();
+        if (now - last_wake > 1) {
+            last_wake = now - 1;
+        }
+        xTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+void lane_pipeline_run(void) {
+    if (!lanes_init()) {
+        PRINTF("[LANE] ERRO: falha ao criar faixas/queue set.\n");
+        return;
+    }
+    xTaskCreatePinnedToCore(task_lane_receiver, "task_lane_rx", RX_STACK_WORDS, NULL,
+                            RX_TASK_PRIO, NULL, APP_PIPE_CORE);
+    xTaskCreatePinnedToCore(task_lane_source, "task_lane_src", GEN_STACK_WORDS, NULL,
+                            GEN_TASK_PRIO, NULL, APP_PIPE_CORE);
+
+    PRINTF("[LANE] RX atende %u itens/s; bulk oferece %u itens/s.\n",
+           (unsigned)(LANE_RX_PER_TICK * configTICK_RATE_HZ),
+           (unsigned)(LANE_BULK_PER_TICK * configTICK_RATE_HZ));
+
+    uint32_t prev_served[LANE_COUNT] = { 0 };
+    uint32_t prev_dropped[LANE_COUNT] = { 0 };
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(LANE_REPORT_MS));
+        for (int l = 0; l < LANE_COUNT; l++) {
+            const lane_stats_t *st = &g_lane_stats[l];
+            uint32_t served = st->served, dropped = st->dropped;
+            PRINTF("[LANE] %-7s: atendido=%" PRIu32 " descartado=%" PRIu32 " itens/s, fila=%u, "
+                   "latência p50=%" PRIu32 " p90=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us\n",
+                   k_lane_name[l],
+                   (served - prev_served[l]) * 1000 / LANE_REPORT_MS,
+                   (dropped - prev_dropped[l]) * 1000 / LANE_REPORT_MS,
+                   (unsigned)lanes_waiting((lane_id_t)l),
+                   lat_hist_percentile(&st->latency, 50), lat_hist_percentile(&st->latency, 90),
+                   lat_hist_percentile(&st->latency, 99), st->latency.max_us);
+            prev_served[l] = served;
+            prev_dropped[l] = dropped;
+        }
+        PRINTF("[LANE] Bulks liberados contra inanição=%" PRIu32
+               ", máx. de bulks à frente de um alarme=%" PRIu32 "\n",
+               g_lane_starve_grants, g_lane_bulk_ahead_max);
+    }
+}
+
+#endif // APP_MODE_LANES
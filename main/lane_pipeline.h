@@ -0,0 +1,21 @@
+#pragma once
+
+/* ==========================
+ *  Alarmes e bulk em faixas de prioridade (APP_MODE_LANES)
+ *  Uma fonte mantém a faixa bulk saturada (oferta acima da capacidade da
+ *  RX) e dispara rajadas de alarmes na faixa urgente. A RX atende no
+ *  máximo LANE_RX_PER_TICK itens por tick pela política de lanes.h.
+ *  Relatório periódico por faixa: vazão, descartes, fila e latência
+ *  p50/p90/p99/máx; e quantos bulks passaram na frente de um alarme.
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria faixas, fonte e RX; relata em seguida (bloqueante). */
+void lane_pipeline_run(void);
+
+#ifdef __cplusplus
+}
+#endif
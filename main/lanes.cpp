@@ -0,0 +1,102 @@
+#include "lanes.h"
+#include "channel.hpp"
+
+#include "freertos/queue.h"
+
+#include "esp_timer.h"
+
+#if APP_MODE_LANES
+
+/* Filas FreeRTOS (o queue set precisa do handle nativo) */
+static chan::Channel<pipe_item_t, LANE_URGENT_LEN, chan::QueueBackend> s_urgent;
+static chan::Channel<pipe_item_t, QUEUE_LEN, chan::QueueBackend> s_bulk;
+static QueueSetHandle_t s_set = nullptr;
+
+/* Estado da RX */
+static uint32_t s_urgent_streak = 0;   // urgentes seguidos com bulk esperando
+static uint32_t s_bulk_ahead = 0;      // bulks servidos desde que o alarme chegou
+static uint32_t s_events = 0;          // eventos do set já retirados pela espera
+
+lane_stats_t g_lane_stats[LANE_COUNT];
+volatile uint32_t g_lane_starve_grants = 0;
+volatile uint32_t g_lane_bulk_ahead_max = 0;
+
+/* Mesma contabilidade do fair.cpp: cada item lido consome um evento */
+static void consume_event()
+{
+    if (s_events > 0) {
+        s_events--;
+    } else {
+        xQueueSelectFromSet(s_set, 0);
+    }
+}
+
+static void served(lane_id_t lane, const pipe_item_t &item)
+{
+    lane_stats_t &st = g_lane_stats[lane];
+    st.served = st.served + 1;
+    lat_hist_record(&st.latency, (uint32_t)esp_timer_get_time() - item.t_enq_us);   // = metrics_now_us()
+}
+
+extern "C" {
+
+bool lanes_init(void)
+{
+    s_set = xQueueCreateSet(LANE_URGENT_LEN + QUEUE_LEN);
+    return s_set && s_urgent.init() && s_bulk.init() &&
+           xQueueAddToSet(s_urgent.native_handle(), s_set) == pdPASS &&
+           xQueueAddToSet(s_bulk.native_handle(), s_set) == pdPASS;
+}
+
+bool lanes_send(lane_id_t lane, const pipe_item_t *item, TickType_t wait)
+{
+    bool ok = lane == LANE_URGENT ? s_urgent.send(*item, wait) : s_bulk.send(*item, wait);
+    lane_stats_t &st = g_lane_stats[lane];
+    if (ok) {
+        st.sent = st.sent + 1;
+    } else {
+        st.dropped = st.dropped + 1;
+    }
+    return ok;
+}
+
+bool lanes_receive(pipe_item_t *out, lane_id_t *lane, TickType_t wait)
+{
+    for (;;) {
+        bool bulk_waiting = s_bulk.size() > 0;
+        bool starving = bulk_waiting && s_urgent_streak >= LANE_URGENT_BURST;
+
+        if (!starving && s_urgent.receive(*out, 0)) {
+            s_urgent_streak = bulk_waiting ? s_urgent_streak + 1 : 0;
+            s_bulk_ahead = 0;
+            *lane = LANE_URGENT;
+        } else if (s_bulk.receive(*out, 0)) {
+            if (starving) {
+                g_lane_starve_grants = g_lane_starve_grants + 1;
+            }
+            s_urgent_streak = 0;
+            if (s_urgent.size() > 0 && ++s_bulk_ahead > g_lane_bulk_ahead_max) {
+                g_lane_bulk_ahead_max = s_bulk_ahead;
+            }
+            *lane = LANE_BULK;
+        } else if (xQueueSelectFromSet(s_set, wait) != nullptr) {
+            s_events++;
+            continue;
+        } else {
+            return false;
+        }
+
+        consume_event();
+        served(*lane, *out);
+        return true;
+    }
+}
+
+size_t lanes_waiting(lane_id_t lane)
+{
+    return lane == LANE_URGENT ? s_urgent.size() : s_bulk.size();
+}
+
+} // extern "C"
+
+#endif // APP_MODE_LANES
@@ -0,0 +1,54 @@
+#pragma once
+
+/* ==========================
+ *  Faixas de prioridade urgente/bulk (APP_MODE_LANES)
+ *  Alarmes vão para uma fila curta própria e nunca esperam atrás dos
+ *  registros bulk: a RX sempre drena a faixa urgente primeiro. Para o
+ *  bulk não morrer de inanição sob uma enxurrada de alarmes, depois de
+ *  LANE_URGENT_BURST urgentes seguidos com bulk esperando um bulk passa
+ *  na frente; um alarme espera no máximo um bulk.
+ *
+ *  As duas filas estão num queue set: a RX bloqueia numa única espera
+ *  (xQueueSelectFromSet). Um consumidor só.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "lat_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LANE_URGENT = 0,
+    LANE_BULK,
+    LANE_COUNT
+} lane_id_t;
+
+/* sent/dropped: escritor é a fonte; o resto é escrito pela RX */
+typedef struct {
+    volatile uint32_t sent;
+    volatile uint32_t dropped;
+    volatile uint32_t served;
+    lat_hist_t latency;          // enfileiramento → retirada pela RX
+} lane_stats_t;
+
+extern lane_stats_t g_lane_stats[LANE_COUNT];
+extern volatile uint32_t g_lane_starve_grants;   // bulks liberados pela proteção
+extern volatile uint32_t g_lane_bulk_ahead_max;  // máx. de bulks servidos com alarme esperando
+
+bool   lanes_init(void);
+bool   lanes_send(lane_id_t lane, const pipe_item_t *item, TickType_t wait);
+/* Próximo item (urgente primeiro); false se nada chegar em `wait` */
+bool   lanes_receive(pipe_item_t *out, lane_id_t *lane, TickType_t wait);
+size_t lanes_waiting(lane_id_t lane);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,64 @@
+#include <string.h>
+
+#include "lat_hist.h"
+
+#define SUB_COUNT  (1u << LAT_HIST_SUB_BITS)
+
+static uint32_t bucket_of(uint32_t us) {
+    if (us < SUB_COUNT) {
+        return us;
+    }
+    uint32_t msb = 31u - (uint32_t)__builtin_clz(us);
+    uint32_t sub = (us >> (msb - LAT_HIST_SUB_BITS)) & (SUB_COUNT - 1);
+    uint32_t idx = (msb - LAT_HIST_SUB_BITS + 1) * SUB_COUNT + sub;
+    return idx < LAT_HIST_BUCKETS ? idx : LAT_HIST_BUCKETS - 1;
+}
+
+/* Limite inferior da faixa (valor representativo) */
+static uint32_t bucket_floor(uint32_t idx) {
+    if (idx < SUB_COUNT) {
+        return idx;
+    }
+    uint32_t msb = idx / SUB_COUNT + LAT_HIST_SUB_BITS - 1;
+    uint32_t sub = idx % SUB_COUNT;
+    return (1u << msb) | (sub << (msb - LAT_HIST_SUB_BITS));
+}
+
+void lat_hist_reset(lat_hist_t *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+void lat_hist_record(lat_hist_t *h, uint32_t us) {
+    h->bucket[bucket_of(us)]++;
+    h->count++;
+    if (us > h->max_us) {
+        h->max_us = us;
+    }
+}
+
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint32_t p) {
+    uint32_t total = h->count;
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = ((uint64_t)total * p + 99) / 100;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        seen += h->bucket[i];
+        if (seen >= rank && seen > 0) {
+            uint32_t v = bucket_floor(i);
+            return v < h->max_us ? v : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+void lat_hist_merge(lat_hist_t *h, const lat_hist_t *other) {
+    for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+        h->bucket[i] += other->bucket[i];
+    }
+    h->count += other->count;
+    if (other->max_us > h->max_us) {
+        h->max_us = other->max_us;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/* ==========================
+ *  Histograma de latência log-linear (µs)
+ *  16 sub-faixas por potência de 2: erro relativo < 6,25% até ~33 s, em
+ *  1,5 KB. Um escritor por histograma; leitores (telemetria) toleram a
+ *  inconsistência de uma contagem em voo.
+ * ========================== */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LAT_HIST_SUB_BITS   4
+#define LAT_HIST_BUCKETS    ((26 - LAT_HIST_SUB_BITS) * (1 << LAT_HIST_SUB_BITS) + (1 << LAT_HIST_SUB_BITS))
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint32_t bucket[LAT_HIST_BUCKETS];
+} lat_hist_t;
+
+void     lat_hist_reset(lat_hist_t *h);
+void     lat_hist_record(lat_hist_t *h, uint32_t us);
+/* Percentil p (0..100) em µs; 0 se vazio */
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint32_t p);
+/* h = h + other (para somar janelas ou estágios) */
+void     lat_hist_merge(lat_hist_t *h, const lat_hist_t *other);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,23 @@
+#include <string.h>
+#include <inttypes.h>
+
+#include "app_config.h"
+#include "metrics.h"
+
+pipe_metrics_t g_metrics;
+
+void metrics_init(void) {
+    memset((void *)&g_metrics, 0, sizeof(g_metrics));
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        g_metrics.stack_min_words[i] = UINT32_MAX;
+    }
+}
+
+void metrics_print_timing(const char *tag) {
+    const lat_hist_t *l = &g_metrics.latency;
+    const lat_hist_t *j = &g_metrics.jitter;
+    PRINTF("%s latência p50=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us | "
+           "jitter p50=%" PRIu32 " p99=%" PRIu32 " max=%" PRIu32 " us (n=%" PRIu32 ")\n",
+           tag, lat_hist_percentile(l, 50), lat_hist_percentile(l, 99), l->max_us,
+           lat_hist_percentile(j, 50), lat_hist_percentile(j, 99), j->max_us, j->count);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+/* ==========================
+ *  Métricas da pipeline
+ *  Contadores com um único escritor cada (GERADOR, RX ou SUP), latência
+ *  enfileiramento→processamento e marca d'água de pilha por estágio.
+ *  Lidas pela telemetria (soak, relatórios) sem bloquear os estágios.
+ * ========================== */
+
+#include <stdint.h>
+
+#include "esp_timer.h"
+
+#include "lat_hist.h"
+#include "pipe_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    STAGE_GEN = 0,
+    STAGE_RX,
+    STAGE_SUP,
+    STAGE_LOG,
+    STAGE_COUNT
+} stage_id_t;
+
+typedef struct {
+    volatile uint32_t produced;                      // GERADOR: itens enfileirados
+    volatile uint32_t dropped;                       // GERADOR: descartes (fila cheia)
+    volatile uint32_t consumed;                      // RX: itens processados
+    volatile uint32_t recoveries;                    // RX: recuperações do canal
+    volatile uint32_t recovery_lost;                 // RX: itens perdidos nelas
+    volatile uint32_t restarts[STAGE_COUNT];         // SUP: recriações por estágio
+    volatile uint32_t stack_min_words[STAGE_COUNT];  // menor marca d'água observada
+    lat_hist_t latency;                              // RX: µs na fila + processamento
+    lat_hist_t jitter;                               // fonte: atraso de liberação (µs)
+} pipe_metrics_t;
+
+extern pipe_metrics_t g_metrics;
+
+void metrics_init(void);
+/* Uma linha com percentis de latência e de jitter de liberação: mesmo
+ * formato em todos os modos de execução, para comparação direta */
+void metrics_print_timing(const char *tag);
+
+/* Carimbo de tempo dos itens (µs, 32 bits – dá a volta a cada ~71 min) */
+static inline uint32_t metrics_now_us(void) {
+    return (uint32_t)esp_timer_get_time();
+}
+
+/* Chamado pela RX ao terminar de processar um item */
+static inline void metrics_on_consumed(const pipe_item_t *item) {
+    g_metrics.consumed++;
+    lat_hist_record(&g_metrics.latency, metrics_now_us() - item->t_enq_us);
+}
+
+/* Fonte liberada em now_us para uma chegada prevista para due_us */
+static inline void metrics_on_release(uint32_t due_us, uint32_t now_us) {
+    int32_t late = (int32_t)(now_us - due_us);
+    lat_hist_record(&g_metrics.jitter, late > 0 ? (uint32_t)late : 0);
+}
+
+/* Registra a marca d'água de pilha (words) do estágio chamador */
+static inline void metrics_stack_mark(stage_id_t stage, uint32_t watermark) {
+    if (watermark < g_metrics.stack_min_words[stage]) {
+        g_metrics.stack_min_words[stage] = watermark;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "wpool.h"
+#include "rob.h"
+#include "parallel.h"
+
+#if APP_MODE_PARALLEL
+
+/* ==========================
+ *  PARÂMETROS
+ * ========================== */
+#define PAR_RECORDS        20000
+#define PAR_BATCH          8       // registros por tarefa
+#define PAR_WORK_ROUNDS    200     // custo base do processamento por registro
+#define PAR_PRIO           RX_TASK_PRIO
+#define PAR_TX_PRIO        (PAR_PRIO + 1)   // entrega em ordem antes de mais processamento
+#define PAR_TIMEOUT_MS     (WDT_TIMEOUT_SECONDS * 1000 / 2)
+#define PAR_ROB_TIMEOUT_MS 50      // cabeça faltando por mais que isso vira lacuna
+
+static const int k_workers[] = { 1, APP_NUM_CORES };
+
+/* Resultado por worker (evita que o processamento seja otimizado fora) */
+static volatile uint32_t s_sink[WPOOL_MAX_WORKERS];
+
+/* Processamento → ROB → transmissão */
+static rob_t s_rob;
+static TaskHandle_t s_ctrl = NULL;
+static volatile bool s_tx_finished = false;
+static volatile bool s_tx_stop = false;
+static volatile uint32_t s_out_of_order = 0;
+
+/* "Processamento" de um registro: custo variável (1x a 4x) conforme o
+ * valor, para que os lotes fiquem desbalanceados e o roubo tenha função */
+static uint32_t process_record(int32_t value) {
+    uint32_t x = (uint32_t)value;
+    uint32_t rounds = PAR_WORK_ROUNDS * (1 + ((uint32_t)value >> 3) % 4);
+    for (uint32_t i = 0; i < rounds; i++) {
+        x = x * 1664525u + 1013904223u;
+    }
+    return x;
+}
+
+/* Cada registro processado vai para o ROB com sua sequência (= valor) */
+static void process_batch(const wpool_task_t *task, int worker) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < task->count; i++) {
+        pipe_item_t item = { .value = task->first + (int32_t)i, .t_enq_us = task->t_enq_us };
+        acc ^= process_record(item.value);
+        rob_put(&s_rob, (uint32_t)item.value, &item, pdMS_TO_TICKS(PAR_TIMEOUT_MS));
+    }
+    s_sink[worker] ^= acc;
+}
+
+/* Transmissão: recebe estritamente em sequência (lacunas já puladas pelo ROB).
+ * Espera em fatias curtas para atender s_tx_stop; a notificação ao
+ * controlador é sempre o último acesso a s_rob (serve de join) */
+static void task_transmit(void *pv) {
+    uint32_t next = 0;
+    TickType_t idle = 0;
+    while (next < PAR_RECORDS && !s_tx_stop) {
+        pipe_item_t item;
+        uint32_t seq;
+        if (!rob_pop(&s_rob, &item, &seq, pdMS_TO_TICKS(PAR_ROB_TIMEOUT_MS))) {
+            idle += pdMS_TO_TICKS(PAR_ROB_TIMEOUT_MS);
+            if (idle >= pdMS_TO_TICKS(PAR_TIMEOUT_MS)) {
+                break;
+            }
+            continue;
+        }
+        idle = 0;
+        if (seq < next || (uint32_t)item.value != seq) {
+            s_out_of_order++;
+        }
+        next = seq + 1;
+        metrics_on_consumed(&item);
+    }
+    s_tx_finished = next >= PAR_RECORDS;
+    xTaskNotifyGive(s_ctrl);
+    vTaskDelete(NULL);
+}
+
+/* Pede o fim da transmissão e espera a notificação de saída. Chamado em
+ * todo caminho de run_config, para que o próximo rob_init não corra com
+ * uma transmissão ainda viva */
+static void transmit_join(bool already_notified) {
+    s_tx_stop = true;
+    if (!already_notified) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);   // a tarefa sai em até PAR_ROB_TIMEOUT_MS
+    }
+}
+
+/* ==========================
+ *  Uma configuração: n workers processando PAR_RECORDS registros
+ *  Retorna o tempo em µs (0 se não terminou no prazo).
+ * ========================== */
+static int64_t run_config(int n) {
+    metrics_init();
+    rob_init(&s_rob, 0, PAR_ROB_TIMEOUT_MS * 1000);
+    s_tx_finished = false;
+    s_tx_stop = false;
+    s_out_of_order = 0;
+    ulTaskNotifyTake(pdTRUE, 0);   // sem sobra de rodada anterior
+    if (xTaskCreatePinnedToCore(task_transmit, "task_transmit", RX_STACK_WORDS, NULL,
+                                PAR_TX_PRIO, NULL, APP_PIPE_CORE) != pdPASS) {
+        PRINTF("[PAR] ERRO: falha ao criar a transmissão.\n");
+        return 0;
+    }
+    if (!wpool_start(n, PAR_PRIO)) {
+        PRINTF("[PAR] ERRO: falha ao criar %d worker(s).\n", n);
+        transmit_join(false);
+        return 0;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    int target = 0;
+    for (int32_t v = 0; v < PAR_RECORDS; v += PAR_BATCH) {
+        wpool_task_t task = {
+            .fn = process_batch,
+            .first = v,
+            .count = PAR_BATCH,
+            .t_enq_us = metrics_now_us(),
+        };
+        /* Rodízio entre as deques: cada trava só é disputada por dono, fonte
+         * e eventual ladrão, e o roubo só acontece com desbalanceamento real
+         * (custo variável dos lotes). Deque cheia: tenta a próxima */
+        while (!wpool_submit(target, &task)) {
+            target = (target + 1) % n;
+            taskYIELD();
+        }
+        target = (target + 1) % n;
+    }
+    /* Fim = último registro entregue em ordem pela transmissão */
+    bool tx_exited = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PAR_TIMEOUT_MS)) != 0;
+    int64_t t1 = esp_timer_get_time();
+    bool done = s_tx_finished && wpool_wait_idle(pdMS_TO_TICKS(PAR_TIMEOUT_MS));
+
+    uint32_t executed = 0, stolen = 0;
+    for (int i = 0; i < n; i++) {
+        wpool_stats_t st;
+        wpool_get_stats(i, &st);
+        executed += st.executed;
+        stolen += st.stolen;
+        PRINTF("[PAR]   worker %d: %" PRIu32 " tarefas (%" PRIu32 " roubadas), %" PRIu32 " registros\n",
+               i, st.executed, st.stolen, st.records);
+    }
+    wpool_stop();
+    transmit_join(tx_exited);
+
+    rob_stats_t rs;
+    rob_get_stats(&s_rob, &rs);
+    PRINTF("[PAR]   ROB: %" PRIu32 " em ordem, %" PRIu32 " fora de ordem, lacunas=%" PRIu32
+           " timeouts=%" PRIu32 " atrasados=%" PRIu32 " estouros=%" PRIu32 " ocupação máx=%" PRIu32 "/%u\n",
+           rs.emitted, s_out_of_order, rs.gaps, rs.timeouts, rs.late, rs.overflow,
+           rs.max_occupancy, (unsigned)ROB_WINDOW);
+    metrics_print_timing("[PAR]  ");
+
+    if (!done) {
+        PRINTF("[PAR] ERRO: %d worker(s) não terminaram em %u ms.\n", n, (unsigned)PAR_TIMEOUT_MS);
+        return 0;
+    }
+
+    uint32_t us = (uint32_t)(t1 - t0);
+    uint32_t rps = (uint32_t)((int64_t)PAR_RECORDS * 1000000 / (t1 - t0));
+    uint32_t steal_x100 = executed ? (uint32_t)((uint64_t)stolen * 10000 / executed) : 0;
+    PRINTF("[PAR] %d worker(s): %" PRIu32 " us, %" PRIu32 " registros/s, roubo %" PRIu32 ".%02" PRIu32 "%%\n",
+           n, us, rps, steal_x100 / 100, steal_x100 % 100);
+    return t1 - t0;
+}
+
+void parallel_run(void) {
+    s_ctrl = xTaskGetCurrentTaskHandle();
+    /* Fonte na mesma prioridade dos workers: cede a CPU quando a deque enche */
+    vTaskPrioritySet(NULL, PAR_PRIO);
+
+    PRINTF("[PAR] %u registros em lotes de %u, até %d worker(s).\n",
+           (unsigned)PAR_RECORDS, (unsigned)PAR_BATCH, WPOOL_MAX_WORKERS);
+
+    int64_t base_us = 0;
+    for (size_t i = 0; i < sizeof(k_workers) / sizeof(k_workers[0]); i++) {
+        int n = k_workers[i];
+        if (i > 0 && n == k_workers[i - 1]) {
+            continue;
+        }
+        int64_t us = run_config(n);
+        if (n == 1) {
+            base_us = us;
+        } else if (base_us > 0 && us > 0) {
+            uint32_t speedup_x100 = (uint32_t)(base_us * 100 / us);
+            PRINTF("[PAR] Speedup com %d workers: %" PRIu32 ".%02" PRIu32 "x\n",
+                   n, speedup_x100 / 100, speedup_x100 % 100);
+        }
+    }
+#if APP_NUM_CORES == 1
+    PRINTF("[PAR] Núcleo único: speedup só é medido com mais de um núcleo.\n");
+#endif
+}
+
+#endif // APP_MODE_PARALLEL
@@ -0,0 +1,25 @@
+#pragma once
+
+/* ==========================
+ *  Processamento paralelo (APP_MODE_PARALLEL)
+ *  A fonte submete lotes de registros como tarefas no pool de workers
+ *  com roubo de trabalho (wpool.h); os registros processados passam pelo
+ *  buffer de reordenação (rob.h) e a transmissão os recebe estritamente
+ *  em sequência. Mede o mesmo lote de registros com 1 worker e com um
+ *  worker por núcleo e reporta:
+ *    - registros/s e tempo total por configuração
+ *    - speedup em relação a 1 worker
+ *    - taxa de roubo (tarefas roubadas / executadas)
+ *    - lacunas, timeouts e ocupação do ROB; latência até a entrega
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Executa a comparação (bloqueante). */
+void parallel_run(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,75 @@
+#include "pipe_channel.h"
+#include "channel.hpp"
+
+#include "freertos/task.h"
+
+/* Instância única, armazenamento estático (.bss) */
+static chan::Channel<pipe_item_t, PIPE_CAPACITY> s_pipe;
+
+/* Buffer de espera da recuperação (só a RX usa) */
+static pipe_item_t s_hold[PIPE_CAPACITY];
+
+#if APP_MODE_STRESS
+static size_t s_depth_limit = PIPE_CAPACITY;
+#endif
+
+extern "C" {
+
+bool pipe_init(void) { return s_pipe.init(); }
+
+bool pipe_send(const pipe_item_t *item, TickType_t wait)
+{
+#if APP_MODE_STRESS
+    if (s_pipe.size() >= s_depth_limit) {
+        return false;
+    }
+#endif
+    return s_pipe.send(*item, wait);
+}
+
+bool pipe_receive(pipe_item_t *out, TickType_t wait) { return s_pipe.receive(*out, wait); }
+
+size_t pipe_send_batch(const pipe_item_t *items, size_t n, TickType_t wait)
+{
+    return s_pipe.send_batch(items, n, wait);
+}
+
+size_t pipe_receive_batch(pipe_item_t *out, size_t max, TickType_t wait)
+{
+    return s_pipe.receive_batch(out, max, wait);
+}
+
+size_t pipe_waiting(void) { return s_pipe.size(); }
+
+void pipe_reset(void) { s_pipe.reset(); }
+
+void pipe_recover(pipe_recover_t *res)
+{
+    size_t n = 0;
+
+    vTaskSuspendAll();
+    while (n < PIPE_CAPACITY && s_pipe.receive(s_hold[n], 0)) {
+        n++;
+    }
+    s_pipe.reset();
+    size_t back = 0;
+    while (back < n && s_pipe.send(s_hold[back], 0)) {
+        back++;
+    }
+    xTaskResumeAll();
+
+    res->drained = n;
+    res->reinjected = back;
+    res->lost = n - back;
+}
+
+void pipe_detach_receiver(void) { s_pipe.detach_receiver(); }
+
+#if APP_MODE_STRESS
+void pipe_set_depth_limit(size_t depth)
+{
+    s_depth_limit = (depth == 0 || depth > PIPE_CAPACITY) ? PIPE_CAPACITY : depth;
+}
+#endif
+
+} // extern "C"
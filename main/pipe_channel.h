@@ -0,0 +1,56 @@
+#pragma once
+
+/* ==========================
+ *  Canal da pipeline GERADOR → RX (API C)
+ *  Fina camada sobre Channel<pipe_item_t, PIPE_CAPACITY> (channel.hpp) para que
+ *  o código C use um canal tipado em vez de g_queue + QUEUE_ITEM_SIZE.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Item transportado pela pipeline */
+typedef struct {
+    int32_t  value;
+    uint32_t t_enq_us;   // carimbo de enfileiramento (metrics_now_us)
+    uint32_t key;        // chave do fluxo (0 = fluxo único)
+} pipe_item_t;
+
+/* Resultado de pipe_recover */
+typedef struct {
+    uint32_t drained;      // itens retirados para o buffer de espera
+    uint32_t reinjected;   // devolvidos ao canal, na ordem original
+    uint32_t lost;         // não couberam de volta
+} pipe_recover_t;
+
+bool   pipe_init(void);
+bool   pipe_send(const pipe_item_t *item, TickType_t wait);
+bool   pipe_receive(pipe_item_t *out, TickType_t wait);
+size_t pipe_send_batch(const pipe_item_t *items, size_t n, TickType_t wait);
+size_t pipe_receive_batch(pipe_item_t *out, size_t max, TickType_t wait);
+size_t pipe_waiting(void);
+void   pipe_reset(void);
+/* Recuperação não destrutiva: drena para um buffer de espera, reinicia o
+ * transporte e reinjeta os itens na mesma ordem. Roda com o escalonador
+ * suspenso, então produtores no mesmo núcleo (caso da pipeline) não
+ * intercalam itens novos durante a operação. */
+void   pipe_recover(pipe_recover_t *res);
+void   pipe_detach_receiver(void);
+
+#if APP_MODE_STRESS
+/* Limita a profundidade efetiva (1..PIPE_CAPACITY) para a varredura do stress */
+void   pipe_set_depth_limit(size_t depth);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+
+#include "esp_system.h"
+#include "esp_task_wdt.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_cpu.h"
+
+#include "app_config.h"
+#include "vclock.h"
+
+/* ==========================
+ *  Stubs do target linux (port POSIX do FreeRTOS)
+ *  Cobrem as APIs do ESP-IDF que a aplicação usa e que não existem no host:
+ *  Task WDT, esp_restart, heap-caps, esp_timer e contador de ciclos.
+ * ========================== */
+
+/* ---------- esp_restart ---------- */
+void esp_restart(void) {
+    PRINTF("[LINUX] esp_restart() – encerrando processo (código %d).\n", LINUX_RESTART_EXIT_CODE);
+    fflush(stdout);
+    exit(LINUX_RESTART_EXIT_CODE);
+}
+
+/* ---------- Relógio ---------- */
+static int64_t host_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+int64_t esp_timer_get_time(void) {
+    if (vclock_active()) {
+        return vclock_now_us();
+    }
+    return host_now_ns() / 1000;
+}
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void) {
+    if (vclock_active()) {
+        return (esp_cpu_cycle_count_t)(vclock_now_us() * 1000);
+    }
+    return (esp_cpu_cycle_count_t)host_now_ns();
+}
+
+/* ---------- esp_timer sobre timers FreeRTOS ---------- */
+struct esp_timer {
+    TimerHandle_t tmr;
+    esp_timer_cb_t cb;
+    void *arg;
+};
+
+static void esp_timer_trampoline(TimerHandle_t t) {
+    struct esp_timer *et = (struct esp_timer *)pvTimerGetTimerID(t);
+    et->cb(et->arg);
+}
+
+static TickType_t us_to_ticks(uint64_t us) {
+    TickType_t ticks = (TickType_t)(us / (1000000 / configTICK_RATE_HZ));
+    return ticks ? ticks : 1;
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args, esp_timer_handle_t *out_handle) {
+    if (!args || !args->callback || !out_handle) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct esp_timer *et = calloc(1, sizeof(*et));
+    if (!et) {
+        return ESP_ERR_NO_MEM;
+    }
+    et->cb = args->callback;
+    et->arg = args->arg;
+    et->tmr = xTimerCreate(args->name ? args->name : "esp_timer", 1, pdFALSE, et, esp_timer_trampoline);
+    if (!et->tmr) {
+        free(et);
+        return ESP_ERR_NO_MEM;
+    }
+    *out_handle = et;
+    return ESP_OK;
+}
+
+static esp_err_t esp_timer_start(esp_timer_handle_t et, uint64_t us, bool periodic) {
+    vTimerSetReloadMode(et->tmr, periodic ? pdTRUE : pdFALSE);
+    return xTimerChangePeriod(et->tmr, us_to_ticks(us), portMAX_DELAY) == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    return esp_timer_start(timer, timeout_us, false);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us) {
+    return esp_timer_start(timer, period_us, true);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    return xTimerStop(timer->tmr, portMAX_DELAY) == pdPASS ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    xTimerDelete(timer->tmr, portMAX_DELAY);
+    free(timer);
+    return ESP_OK;
+}
+
+/* ---------- heap-caps ----------
+ * Orçamento fixo menos o que o processo alocou desde o início (mallinfo2).
+ * Fora da glibc não há contabilidade: reporta o orçamento inteiro. */
+#define LINUX_HEAP_BUDGET   (320 * 1024)
+
+static size_t s_heap_base = 0;
+static size_t s_heap_min  = LINUX_HEAP_BUDGET;
+
+static size_t heap_used(void) {
+#if defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+__attribute__((constructor)) static void heap_stub_init(void) {
+    s_heap_base = heap_used();
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    size_t used = heap_used() - s_heap_base;
+    size_t free_sz = used < LINUX_HEAP_BUDGET ? LINUX_HEAP_BUDGET - used : 0;
+    if (free_sz < s_heap_min) {
+        s_heap_min = free_sz;
+    }
+    return free_sz;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    heap_caps_get_free_size(caps);
+    return s_heap_min;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return heap_caps_get_free_size(caps);
+}
+
+/* ---------- Task WDT ----------
+ * Registro simples de tarefas + timer FreeRTOS que verifica o último reset
+ * de cada uma a cada timeout. Com trigger_panic, aborta como o IDF faria. */
+#define WDT_STUB_MAX_TASKS  8
+
+typedef struct {
+    TaskHandle_t task;
+    TickType_t last_reset;
+} wdt_entry_t;
+
+static wdt_entry_t s_wdt[WDT_STUB_MAX_TASKS];
+static esp_task_wdt_config_t s_wdt_cfg;
+static TimerHandle_t s_wdt_timer = NULL;
+
+void __attribute__((weak)) esp_task_wdt_isr_user_handler(void) {
+}
+
+static void wdt_check(TimerHandle_t t) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t limit = pdMS_TO_TICKS(s_wdt_cfg.timeout_ms);
+    bool fired = false;
+
+    vTaskSuspendAll();
+    for (int i = 0; i < WDT_STUB_MAX_TASKS; i++) {
+        if (s_wdt[i].task && (now - s_wdt[i].last_reset) > limit) {
+            printf("E task_wdt: Task watchdog got triggered. Task não resetou: %s\n",
+                   pcTaskGetName(s_wdt[i].task));
+            fired = true;
+        }
+    }
+    xTaskResumeAll();
+
+    if (fired) {
+        esp_task_wdt_isr_user_handler();
+    }
+    if (fired && s_wdt_cfg.trigger_panic) {
+        printf("E task_wdt: Aborting.\n");
+        fflush(stdout);
+        abort();
+    }
+}
+
+esp_err_t esp_task_wdt_init(const esp_task_wdt_config_t *config) {
+    if (s_wdt_timer) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_wdt_cfg = *config;
+    s_wdt_timer = xTimerCreate("task_wdt", pdMS_TO_TICKS(config->timeout_ms), pdTRUE, NULL, wdt_check);
+    if (!s_wdt_timer) {
+        return ESP_ERR_NO_MEM;
+    }
+    xTimerStart(s_wdt_timer, portMAX_DELAY);
+    return ESP_OK;
+}
+
+esp_err_t esp_task_wdt_deinit(void) {
+    if (!s_wdt_timer) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xTimerDelete(s_wdt_timer, portMAX_DELAY);
+    s_wdt_timer = NULL;
+    for (int i = 0; i < WDT_STUB_MAX_TASKS; i++) {
+        s_wdt[i].task = NULL;
+    }
+    return ESP_OK;
+}
+
+static wdt_entry_t *wdt_find(TaskHandle_t task) {
+    for (int i = 0; i < WDT_STUB_MAX_TASKS; i++) {
+        if (s_wdt[i].task == task) {
+            return &s_wdt[i];
+        }
+    }
+    return NULL;
+}
+
+esp_err_t esp_task_wdt_add(TaskHandle_t task_handle) {
+    TaskHandle_t task = task_handle ? task_handle : xTaskGetCurrentTaskHandle();
+    esp_err_t err = ESP_ERR_NO_MEM;
+
+    vTaskSuspendAll();
+    wdt_entry_t *e = wdt_find(task);
+    if (e) {
+        err = ESP_ERR_INVALID_ARG;
+    } else if ((e = wdt_find(NULL)) != NULL) {
+        e->task = task;
+        e->last_reset = xTaskGetTickCount();
+        err = ESP_OK;
+    }
+    xTaskResumeAll();
+    return err;
+}
+
+esp_err_t esp_task_wdt_reset(void) {
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+
+    vTaskSuspendAll();
+    wdt_entry_t *e = wdt_find(xTaskGetCurrentTaskHandle());
+    if (e) {
+        e->last_reset = xTaskGetTickCount();
+        err = ESP_OK;
+    }
+    xTaskResumeAll();
+    return err;
+}
+
+esp_err_t esp_task_wdt_delete(TaskHandle_t task_handle) {
+    TaskHandle_t task = task_handle ? task_handle : xTaskGetCurrentTaskHandle();
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+
+    vTaskSuspendAll();
+    wdt_entry_t *e = wdt_find(task);
+    if (e) {
+        e->task = NULL;
+        err = ESP_OK;
+    }
+    xTaskResumeAll();
+    return err;
+}
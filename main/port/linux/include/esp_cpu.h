@@ -0,0 +1,18 @@
+#pragma once
+
+/* Stub de esp_cpu para o target linux: o "contador de ciclos" anda em ns
+ * (APP_CPU_FREQ_MHZ = 1000), derivado de esp_timer_get_time(). */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void);
+
+#ifdef __cplusplus
+}
+#endif
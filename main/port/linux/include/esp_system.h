@@ -0,0 +1,19 @@
+#pragma once
+
+/* Stub de esp_system para o target linux: esp_restart() encerra o processo
+ * com LINUX_RESTART_EXIT_CODE para o harness de teste distinguir reinício
+ * de falha. */
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LINUX_RESTART_EXIT_CODE  3
+
+void esp_restart(void) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+/* Stub do Task WDT para o target linux (port/linux/esp_stubs.c).
+ * Mesma API do ESP-IDF; a checagem roda num timer FreeRTOS, então segue o
+ * tempo virtual quando APP_VIRTUAL_TIME está ativo. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t timeout_ms;
+    uint32_t idle_core_mask;
+    bool trigger_panic;
+} esp_task_wdt_config_t;
+
+esp_err_t esp_task_wdt_init(const esp_task_wdt_config_t *config);
+esp_err_t esp_task_wdt_deinit(void);
+esp_err_t esp_task_wdt_add(TaskHandle_t task_handle);
+esp_err_t esp_task_wdt_reset(void);
+esp_err_t esp_task_wdt_delete(TaskHandle_t task_handle);
+
+/* Chamado quando o WDT dispara, antes de abortar (fraco, redefinível) */
+void esp_task_wdt_isr_user_handler(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+/* ==========================
+ *  Relógio virtual (APP_VIRTUAL_TIME, só target linux)
+ *  Desliga o tick real do port POSIX e avança o tick do FreeRTOS sempre que
+ *  todas as tarefas da aplicação estão bloqueadas. O tempo passa a ser uma
+ *  simulação de eventos discretos: determinística e tão rápida quanto a
+ *  CPU do host permitir (horas simuladas em segundos).
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Inicia o relógio virtual. Chamar no início de app_main. */
+bool vclock_start(void);
+
+/* Tempo virtual decorrido, em µs (múltiplo do período de tick). */
+int64_t vclock_now_us(void);
+
+bool vclock_active(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+#include "vclock.h"
+
+/* Um nível acima do idle: só ganha a CPU quando todas as tarefas da
+ * aplicação estão bloqueadas (a mais baixa delas também roda em
+ * tskIDLE_PRIORITY + 1 e alterna com esta por fatia de tempo). Estar acima
+ * do idle faz o xTaskCatchUpTicks() só pedir troca de contexto quando o tick
+ * desbloqueia alguém – com os dois no mesmo nível, a fatia de tempo pediria
+ * troca a todo tick. */
+#define VCLOCK_PRIO          (tskIDLE_PRIORITY + 1)
+#define VCLOCK_STACK_WORDS   2048
+/* Teto de ticks avançados numa ativação, para o idle rodar (e liberar TCBs
+ * de tarefas apagadas) mesmo sem nenhum timeout pendente */
+#define VCLOCK_MAX_SKIP      configTICK_RATE_HZ
+
+static volatile bool s_active = false;
+
+static void vclock_task(void *pv) {
+    for (;;) {
+        /* Salta direto ao timeout mais próximo: avança tick a tick sem ceder
+         * a CPU até o tick que desbloqueia uma tarefa; aí o próprio
+         * xTaskCatchUpTicks() troca para ela. O kernel não expõe o próximo
+         * instante de desbloqueio, e avançar N ticks de uma vez acordaria a
+         * tarefa atrasada. */
+        uint32_t skipped = 0;
+        while (xTaskCatchUpTicks(1) == pdFALSE && ++skipped < VCLOCK_MAX_SKIP) {
+        }
+        /* Desce ao nível do idle e volta: ele roda uma passada e cede
+         * (configIDLE_SHOULD_YIELD) */
+        vTaskPrioritySet(NULL, tskIDLE_PRIORITY);
+        vTaskPrioritySet(NULL, VCLOCK_PRIO);
+    }
+}
+
+bool vclock_start(void) {
+    /* O port POSIX gera o tick com ITIMER_REAL; desligado, só o relógio
+     * virtual faz o tempo andar e a execução fica determinística. */
+    struct itimerval off = { 0 };
+    struct itimerval old = { 0 };
+    bool stopped = setitimer(ITIMER_REAL, &off, &old) == 0 &&
+                   (old.it_interval.tv_sec != 0 || old.it_interval.tv_usec != 0);
+    if (!stopped) {
+        PRINTF("[VCLOCK] Aviso: tick real não encontrado em ITIMER_REAL – "
+               "tempo virtual ativo, mas sem garantia de determinismo.\n");
+    }
+
+    if (xTaskCreate(vclock_task, "vclock", VCLOCK_STACK_WORDS, NULL, VCLOCK_PRIO, NULL) != pdPASS) {
+        PRINTF("[VCLOCK] ERRO: falha ao criar tarefa do relógio virtual.\n");
+        return false;
+    }
+    s_active = true;
+    PRINTF("[VCLOCK] Tempo virtual ativo (%d Hz).\n", configTICK_RATE_HZ);
+    return true;
+}
+
+int64_t vclock_now_us(void) {
+    return (int64_t)xTaskGetTickCount() * (1000000 / configTICK_RATE_HZ);
+}
+
+bool vclock_active(void) {
+    return s_active;
+}
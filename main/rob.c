@@ -0,0 +1,155 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "rob.h"
+
+void rob_init(rob_t *r, uint32_t first_seq, uint32_t timeout_us) {
+    memset(r, 0, sizeof(*r));
+    r->lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    r->next = first_seq;
+    r->timeout_us = timeout_us;
+}
+
+/* Chamadas com a trava: retiram os handles; a notificação vai depois */
+static int take_producers(rob_t *r, TaskHandle_t *out) {
+    int n = 0;
+    for (int i = 0; i < ROB_MAX_PRODUCERS; i++) {
+        if (r->producers[i]) {
+            out[n++] = r->producers[i];
+            r->producers[i] = NULL;
+        }
+    }
+    return n;
+}
+
+static bool add_producer(rob_t *r, TaskHandle_t self) {
+    for (int i = 0; i < ROB_MAX_PRODUCERS; i++) {
+        if (r->producers[i] == self) {
+            return true;
+        }
+    }
+    for (int i = 0; i < ROB_MAX_PRODUCERS; i++) {
+        if (!r->producers[i]) {
+            r->producers[i] = self;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void notify_all(TaskHandle_t *tasks, int n) {
+    for (int i = 0; i < n; i++) {
+        xTaskNotifyGive(tasks[i]);
+    }
+}
+
+rob_put_result_t rob_put(rob_t *r, uint32_t seq, const pipe_item_t *item, TickType_t wait) {
+    TickType_t start = xTaskGetTickCount();
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    for (;;) {
+        portENTER_CRITICAL(&r->lock);
+        int32_t ahead = (int32_t)(seq - r->next);
+        if (ahead < 0) {
+            r->stats.late++;
+            portEXIT_CRITICAL(&r->lock);
+            return ROB_LATE;
+        }
+        if (ahead < ROB_WINDOW) {
+            uint32_t i = seq % ROB_WINDOW;
+            r->slots[i] = *item;
+            r->full[i] = true;
+            if (++r->count > r->stats.max_occupancy) {
+                r->stats.max_occupancy = r->count;
+            }
+            TaskHandle_t c = r->consumer;
+            r->consumer = NULL;
+            portEXIT_CRITICAL(&r->lock);
+            if (c) {
+                xTaskNotifyGive(c);
+            }
+            return ROB_OK;
+        }
+
+        /* Fora da janela: espera a transmissão entregar a cabeça */
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        bool can_wait = (wait == portMAX_DELAY || elapsed < wait) && add_producer(r, self);
+        if (!can_wait) {
+            r->stats.overflow++;
+            portEXIT_CRITICAL(&r->lock);
+            return ROB_FULL;
+        }
+        portEXIT_CRITICAL(&r->lock);
+        ulTaskNotifyTake(pdTRUE, wait == portMAX_DELAY ? portMAX_DELAY : wait - elapsed);
+    }
+}
+
+bool rob_pop(rob_t *r, pipe_item_t *out, uint32_t *seq, TickType_t wait) {
+    TickType_t start = xTaskGetTickCount();
+    TaskHandle_t waiters[ROB_MAX_PRODUCERS];
+
+    for (;;) {
+        portENTER_CRITICAL(&r->lock);
+        uint32_t i = r->next % ROB_WINDOW;
+        if (r->full[i]) {
+            *out = r->slots[i];
+            *seq = r->next;
+            r->full[i] = false;
+            r->count--;
+            r->next++;
+            r->head_wait_since = 0;
+            r->stats.emitted++;
+            int n = take_producers(r, waiters);
+            portEXIT_CRITICAL(&r->lock);
+            notify_all(waiters, n);
+            return true;
+        }
+
+        /* Cabeça faltando: só conta como lacuna se há registros parados atrás */
+        TickType_t nap = portMAX_DELAY;
+        if (r->count == 0) {
+            r->head_wait_since = 0;
+        } else {
+            int64_t now = esp_timer_get_time();
+            if (r->head_wait_since == 0) {
+                r->head_wait_since = now;
+            }
+            int64_t waited = now - r->head_wait_since;
+            if (waited >= r->timeout_us) {
+                while (!r->full[r->next % ROB_WINDOW]) {
+                    r->next++;
+                    r->stats.gaps++;
+                }
+                r->stats.timeouts++;
+                r->head_wait_since = 0;
+                int n = take_producers(r, waiters);
+                portEXIT_CRITICAL(&r->lock);
+                notify_all(waiters, n);
+                continue;
+            }
+            nap = pdMS_TO_TICKS((r->timeout_us - waited) / 1000) + 1;
+        }
+
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (wait != portMAX_DELAY && elapsed >= wait) {
+            portEXIT_CRITICAL(&r->lock);
+            return false;
+        }
+        if (wait != portMAX_DELAY && wait - elapsed < nap) {
+            nap = wait - elapsed;
+        }
+        r->consumer = xTaskGetCurrentTaskHandle();
+        portEXIT_CRITICAL(&r->lock);
+        ulTaskNotifyTake(pdTRUE, nap);
+    }
+}
+
+void rob_get_stats(rob_t *r, rob_stats_t *out) {
+    portENTER_CRITICAL(&r->lock);
+    *out = r->stats;
+    portEXIT_CRITICAL(&r->lock);
+}
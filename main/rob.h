@@ -0,0 +1,71 @@
+#pragma once
+
+/* ==========================
+ *  Buffer de reordenação (ROB) entre processamento e transmissão
+ *  Workers em núcleos diferentes terminam registros fora de ordem; o ROB
+ *  os guarda por número de sequência numa janela limitada e a
+ *  transmissão só recebe o próximo da sequência.
+ *    - Registro além da janela: o produtor espera a janela andar
+ *      (contrapressão), até `wait`.
+ *    - Cabeça faltando com registros parados atrás por mais de
+ *      timeout_us: a sequência pula até o próximo presente (lacuna
+ *      contada); um atrasado que chegue depois é descartado (late).
+ *  Vários produtores, um consumidor; uma trava curta (portMUX) por ROB.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "pipe_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ROB_WINDOW          64   // registros guardados no máximo
+#define ROB_MAX_PRODUCERS   4    // produtores esperando janela ao mesmo tempo
+
+typedef enum {
+    ROB_OK = 0,
+    ROB_LATE,       // sequência já pulada por timeout: descartado
+    ROB_FULL,       // janela não andou dentro de `wait`: descartado
+} rob_put_result_t;
+
+typedef struct {
+    uint32_t emitted;        // entregues em ordem
+    uint32_t gaps;           // números de sequência pulados
+    uint32_t timeouts;       // pulos por timeout da cabeça
+    uint32_t late;           // chegaram depois do pulo
+    uint32_t overflow;       // desistiram de esperar janela
+    uint32_t max_occupancy;  // maior n° de registros guardados
+} rob_stats_t;
+
+typedef struct {
+    portMUX_TYPE lock;
+    uint32_t next;                 // próxima sequência a entregar
+    uint32_t count;                // registros guardados
+    uint32_t timeout_us;
+    int64_t  head_wait_since;      // cabeça faltando desde (0 = não)
+    TaskHandle_t consumer;         // esperando a cabeça
+    TaskHandle_t producers[ROB_MAX_PRODUCERS];   // esperando janela
+    rob_stats_t stats;
+    bool full[ROB_WINDOW];
+    pipe_item_t slots[ROB_WINDOW];
+} rob_t;
+
+/* Sem produtores nem consumidor ativos */
+void rob_init(rob_t *r, uint32_t first_seq, uint32_t timeout_us);
+
+rob_put_result_t rob_put(rob_t *r, uint32_t seq, const pipe_item_t *item, TickType_t wait);
+
+/* Próximo registro em ordem; false se `wait` expirar sem nada a entregar */
+bool rob_pop(rob_t *r, pipe_item_t *out, uint32_t *seq, TickType_t wait);
+
+void rob_get_stats(rob_t *r, rob_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
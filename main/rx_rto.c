@@ -0,0 +1,77 @@
+#include <stdlib.h>
+
+#include "app_config.h"
+#include "rx_rto.h"
+
+#define RTO_K            4      // peso do desvio
+#define RTO_TICK_US      (1000000 / configTICK_RATE_HZ)   // granularidade G
+
+/* Silêncio (ms) que leva a RX_FAIL_THRESHOLD timeouts seguidos partindo do
+ * piso, com o backoff de rx_rto_on_timeout */
+#define RTO_BACKOFF_MS(n)   ((n) >= RX_FAIL_THRESHOLD ? 0 : \
+                             (RX_RTO_MIN_MS << (n)) < RX_TIMEOUT_MS ? (RX_RTO_MIN_MS << (n)) : RX_TIMEOUT_MS)
+#define RTO_SILENCE_MS      (RTO_BACKOFF_MS(0) + RTO_BACKOFF_MS(1) + RTO_BACKOFF_MS(2) + \
+                             RTO_BACKOFF_MS(3) + RTO_BACKOFF_MS(4) + RTO_BACKOFF_MS(5) + \
+                             RTO_BACKOFF_MS(6) + RTO_BACKOFF_MS(7))
+
+_Static_assert(RX_FAIL_THRESHOLD <= 8, "RTO_SILENCE_MS soma só 8 termos");
+#if APP_RX_ADAPTIVE_TIMEOUT
+/* A pausa do perfil on/off não pode derrubar a RX a cada ciclo */
+_Static_assert(TRAFFIC_BURST_OFF_MS < RTO_SILENCE_MS,
+               "pausa do perfil on/off atinge RX_FAIL_THRESHOLD timeouts");
+#endif
+
+static uint32_t clamp_rto(int64_t us) {
+    if (us < (int64_t)RX_RTO_MIN_MS * 1000) {
+        return RX_RTO_MIN_MS * 1000;
+    }
+    if (us > (int64_t)RX_TIMEOUT_MS * 1000) {
+        return RX_TIMEOUT_MS * 1000;
+    }
+    return (uint32_t)us;
+}
+
+void rx_rto_init(rx_rto_t *r) {
+    r->srtt_us = 0;
+    r->rttvar_us = 0;
+    r->rto_us = RX_TIMEOUT_MS * 1000;
+    r->last_us = 0;
+    r->has_last = false;
+    r->primed = false;
+}
+
+void rx_rto_on_arrival(rx_rto_t *r, uint32_t now_us) {
+#if APP_RX_ADAPTIVE_TIMEOUT
+    if (r->has_last) {
+        int32_t sample = (int32_t)(now_us - r->last_us);
+        if (!r->primed) {
+            r->srtt_us = sample;
+            r->rttvar_us = sample / 2;
+            r->primed = true;
+        } else {
+            int32_t err = sample - r->srtt_us;
+            r->srtt_us += err / 8;
+            r->rttvar_us += (abs(err) - r->rttvar_us) / 4;
+        }
+        int32_t var = RTO_K * r->rttvar_us;
+        r->rto_us = clamp_rto((int64_t)r->srtt_us + (var > RTO_TICK_US ? var : RTO_TICK_US));
+    }
+#endif
+    r->last_us = now_us;
+    r->has_last = true;
+}
+
+void rx_rto_on_timeout(rx_rto_t *r) {
+    /* RFC 6298 §5.5: dobra até a próxima amostra válida. Sem isso a
+     * estimativa congela no piso quando o tráfego para (Karn descarta
+     * todo intervalo que atravessa timeout) */
+#if APP_RX_ADAPTIVE_TIMEOUT
+    r->rto_us = clamp_rto((int64_t)r->rto_us * 2);
+#endif
+    r->has_last = false;
+}
+
+TickType_t rx_rto_ticks(const rx_rto_t *r) {
+    TickType_t t = pdMS_TO_TICKS((r->rto_us + 999) / 1000);
+    return t ? t : 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/* ==========================
+ *  Timeout adaptativo da RX (estilo RTO do TCP, RFC 6298)
+ *  Estima o intervalo entre chegadas com EWMA de média (ganho 1/8) e de
+ *  desvio (ganho 1/4); timeout = média + 4·desvio, limitado a
+ *  [RX_RTO_MIN_MS, RX_TIMEOUT_MS]. Antes da primeira amostra vale
+ *  RX_TIMEOUT_MS. Como no algoritmo de Karn, o intervalo que atravessa um
+ *  timeout não vira amostra: uma pane não infla a estimativa. Cada
+ *  timeout dobra o valor (até o teto), como no backoff do TCP.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int32_t srtt_us;      // média suavizada do intervalo
+    int32_t rttvar_us;    // desvio médio suavizado
+    uint32_t rto_us;      // timeout atual
+    uint32_t last_us;     // última chegada
+    bool has_last;        // last_us válido (falso no início e após timeout)
+    bool primed;          // já recebeu a primeira amostra
+} rx_rto_t;
+
+void rx_rto_init(rx_rto_t *r);
+/* Chegada de um item no instante now_us (metrics_now_us) */
+void rx_rto_on_arrival(rx_rto_t *r, uint32_t now_us);
+/* Expirou a espera: dobra o timeout; o próximo intervalo não é amostrado */
+void rx_rto_on_timeout(rx_rto_t *r);
+/* Espera atual em ticks (>= 1) */
+TickType_t rx_rto_ticks(const rx_rto_t *r);
+
+static inline uint32_t rx_rto_ms(const rx_rto_t *r) { return r->rto_us / 1000; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,47 @@
+#include "shard.h"
+#include "channel.hpp"
+
+#if APP_MODE_SHARDED
+
+/* Um canal por shard, armazenamento estático (.bss) */
+static chan::Channel<pipe_item_t, QUEUE_LEN> s_shards[APP_SHARDS];
+
+shard_stats_t g_shard_stats[APP_SHARDS];
+
+extern "C" {
+
+bool shard_init(void)
+{
+    for (auto &ch : s_shards) {
+        if (!ch.init()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool shard_send(const pipe_item_t *item, TickType_t wait)
+{
+    int s = shard_of(item->key);
+    if (s_shards[s].send(*item, wait)) {
+        g_shard_stats[s].routed = g_shard_stats[s].routed + 1;
+        return true;
+    }
+    g_shard_stats[s].dropped = g_shard_stats[s].dropped + 1;
+    return false;
+}
+
+bool shard_receive(int shard, pipe_item_t *out, TickType_t wait)
+{
+    if (s_shards[shard].receive(*out, wait)) {
+        g_shard_stats[shard].consumed = g_shard_stats[shard].consumed + 1;
+        return true;
+    }
+    return false;
+}
+
+size_t shard_waiting(int shard) { return s_shards[shard].size(); }
+
+} // extern "C"
+
+#endif // APP_MODE_SHARDED
@@ -0,0 +1,52 @@
+#pragma once
+
+/* ==========================
+ *  Canais por shard (APP_MODE_SHARDED)
+ *  APP_SHARDS canais independentes Channel<pipe_item_t, QUEUE_LEN>, um
+ *  por shard. O registro vai para o shard hash(key) % APP_SHARDS: todos
+ *  os registros de uma chave passam pelo mesmo canal e pelo mesmo
+ *  consumidor, então a ordem por chave se mantém. Shards não
+ *  compartilham trava nem contador.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Contadores de um shard: cada campo tem um único escritor (roteador ou
+ * consumidor do shard) */
+typedef struct {
+    volatile uint32_t routed;     // roteador: enfileirados
+    volatile uint32_t dropped;    // roteador: canal cheio
+    volatile uint32_t consumed;   // consumidor: processados
+} shard_stats_t;
+
+extern shard_stats_t g_shard_stats[APP_SHARDS];
+
+/* Espalha chaves sequenciais (finalizador do murmur3) */
+static inline int shard_of(uint32_t key) {
+    key ^= key >> 16;
+    key *= 0x85ebca6bu;
+    key ^= key >> 13;
+    key *= 0xc2b2ae35u;
+    key ^= key >> 16;
+    return (int)(key % APP_SHARDS);
+}
+
+bool shard_init(void);
+/* Roteia pela chave; não bloqueia além de `wait` no canal do shard */
+bool shard_send(const pipe_item_t *item, TickType_t wait);
+bool shard_receive(int shard, pipe_item_t *out, TickType_t wait);
+size_t shard_waiting(int shard);
+
+#ifdef __cplusplus
+}
+#endif
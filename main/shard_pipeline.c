@@ -0,0 +1,139 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "shard.h"
+#include "shard_pipeline.h"
+
+#if APP_MODE_SHARDED
+
+/* ==========================
+ *  PARÂMETROS
+ * ========================== */
+#define SHARD_STREAMS        32     // fluxos (chaves) distintos
+#define SHARD_BURST          32     // registros por tick da fonte
+#define SHARD_WORK_ROUNDS    100    // "processamento" por registro
+#define SHARD_REPORT_MS      2000
+
+/* Estado de cada consumidor: só a própria tarefa escreve */
+typedef struct {
+    int32_t last[SHARD_STREAMS];    // última sequência vista por chave
+    volatile uint32_t out_of_order;
+    volatile uint32_t sink;
+    lat_hist_t latency;
+} shard_consumer_t;
+
+static shard_consumer_t s_cons[APP_SHARDS];
+
+/* ==========================
+ *  Fonte: rajada de SHARD_BURST registros por tick, chaves em rodízio
+ * ========================== */
+static void task_shard_source(void *pv) {
+    static int32_t seq[SHARD_STREAMS];
+    uint32_t key = 0;
+    TickType_t last_wake = xTaskGetTickCount();
+
+    for (;;) {
+        uint32_t now = metrics_now_us();
+        for (int i = 0; i < SHARD_BURST; i++) {
+            pipe_item_t item = { .value = seq[key], .t_enq_us = now, .key = key };
+            if (shard_send(&item, 0)) {
+                seq[key]++;        // descartado = a mesma sequência vai de novo
+            }
+            key = (key + 1) % SHARD_STREAMS;
+        }
+        xTaskDelayUntil(&last_wake, 1);
+    }
+}
+
+/* ==========================
+ *  Consumidor do shard: confere a ordem por chave e "processa"
+ * ========================== */
+static void task_shard_consumer(void *pv) {
+    int shard = (int)(intptr_t)pv;
+    shard_consumer_t *c = &s_cons[shard];
+
+    for (;;) {
+        pipe_item_t item;
+        if (!shard_receive(shard, &item, portMAX_DELAY)) {
+            continue;
+        }
+        if (item.value != c->last[item.key] + 1) {
+            c->out_of_order++;
+        }
+        c->last[item.key] = item.value;
+
+        uint32_t x = (uint32_t)item.value;
+        for (int i = 0; i < SHARD_WORK_ROUNDS; i++) {
+            x = x * 1664525u + 1013904223u;
+        }
+        c->sink ^= x;
+        lat_hist_record(&c->latency, metrics_now_us() - item.t_enq_us);
+    }
+}
+
+/* ==========================
+ *  Relatório
+ * ========================== */
+static void report(const uint32_t *prev, uint32_t *cur, uint32_t window_ms) {
+    uint32_t total = 0, max = 0;
+    for (int s = 0; s < APP_SHARDS; s++) {
+        cur[s] = g_shard_stats[s].consumed;
+        uint32_t d = cur[s] - prev[s];
+        total += d;
+        if (d > max) {
+            max = d;
+        }
+        const shard_consumer_t *c = &s_cons[s];
+        PRINTF("[SHARD] %d (núcleo %d): %" PRIu32 " itens/s, descartes=%" PRIu32 ", fila=%u, "
+               "fora de ordem=%" PRIu32 ", latência p50=%" PRIu32 " p99=%" PRIu32 " us\n",
+               s, SHARD_CORE(s), d * 1000 / window_ms, g_shard_stats[s].dropped,
+               (unsigned)shard_waiting(s), c->out_of_order,
+               lat_hist_percentile(&c->latency, 50), lat_hist_percentile(&c->latency, 99));
+    }
+    uint32_t imbalance_x100 = total ? max * APP_SHARDS * 100 / total : 0;
+    PRINTF("[SHARD] Total %" PRIu32 " itens/s, desbalanceamento %" PRIu32 ".%02" PRIu32 "x (máx/média)\n",
+           total * 1000 / window_ms, imbalance_x100 / 100, imbalance_x100 % 100);
+}
+
+void shard_pipeline_run(void) {
+    if (!shard_init()) {
+        PRINTF("[SHARD] ERRO: falha ao criar os canais.\n");
+        return;
+    }
+
+    /* Sequência começa em 0: a "anterior" de cada chave é -1 */
+    for (int s = 0; s < APP_SHARDS; s++) {
+        for (int k = 0; k < SHARD_STREAMS; k++) {
+            s_cons[s].last[k] = -1;
+        }
+        char name[16];
+        snprintf(name, sizeof(name), "task_shard%d", s);
+        xTaskCreatePinnedToCore(task_shard_consumer, name, RX_STACK_WORDS, (void *)(intptr_t)s,
+                                RX_TASK_PRIO, NULL, SHARD_CORE(s));
+    }
+    xTaskCreatePinnedToCore(task_shard_source, "task_shard_src", GEN_STACK_WORDS, NULL,
+                            GEN_TASK_PRIO, NULL, APP_PIPE_CORE);
+
+    PRINTF("[SHARD] %d shards, %d fluxos, %d registros por tick.\n",
+           APP_SHARDS, SHARD_STREAMS, SHARD_BURST);
+
+    uint32_t prev[APP_SHARDS] = { 0 };
+    uint32_t cur[APP_SHARDS];
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(SHARD_REPORT_MS));
+        report(prev, cur, SHARD_REPORT_MS);
+        for (int s = 0; s < APP_SHARDS; s++) {
+            prev[s] = cur[s];
+        }
+    }
+}
+
+#endif // APP_MODE_SHARDED
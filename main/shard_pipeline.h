@@ -0,0 +1,22 @@
+#pragma once
+
+/* ==========================
+ *  Pipelines particionadas por chave (APP_MODE_SHARDED)
+ *  Uma fonte gera SHARD_STREAMS fluxos independentes (chave = n° do
+ *  fluxo, valor = sequência dentro do fluxo) e os roteia por hash da
+ *  chave para APP_SHARDS shards, cada um com canal e consumidor próprios
+ *  no núcleo SHARD_CORE(i). Cada consumidor confere a ordem por chave.
+ *  Relatório periódico: vazão, descartes e latência por shard, e o
+ *  desbalanceamento (carga do shard mais cheio / carga média).
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria canais, consumidores e a fonte; relata em seguida (bloqueante). */
+void shard_pipeline_run(void);
+
+#ifdef __cplusplus
+}
+#endif
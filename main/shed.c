@@ -0,0 +1,71 @@
+#include "app_config.h"
+#include "shed.h"
+
+/* ==========================
+ *  PARÂMETROS DA ESCADA (bytes de heap livre)
+ * ========================== */
+#define SHED_HYSTERESIS_BYTES    (4 * 1024)
+#define SHED_RELAX_PERIODS       2   // períodos folgados antes de descer
+#define SHED_REBOOT_BYTES        (8 * 1024)
+#define SHED_REBOOT_PERIODS      3   // períodos críticos no último degrau
+
+/* Limite de entrada de cada degrau (índice = degrau) */
+static const size_t k_enter[SHED_LEVEL_COUNT] = {
+    [SHED_NORMAL]    = 0,
+    [SHED_RATE_HALF] = 24 * 1024,
+    [SHED_NO_LOGGER] = 16 * 1024,
+    [SHED_RATE_MIN]  = 12 * 1024,
+    [SHED_REBOOT]    = SHED_REBOOT_BYTES,
+};
+
+static const char *const k_names[SHED_LEVEL_COUNT] = {
+    [SHED_NORMAL]    = "normal",
+    [SHED_RATE_HALF] = "taxa/2",
+    [SHED_NO_LOGGER] = "sem logger",
+    [SHED_RATE_MIN]  = "taxa/8",
+    [SHED_REBOOT]    = "reinício",
+};
+
+volatile shed_level_t g_shed_level = SHED_NORMAL;
+
+static uint32_t s_relax = 0;
+static uint32_t s_critical = 0;
+
+const char *shed_level_name(shed_level_t level) {
+    return level < SHED_LEVEL_COUNT ? k_names[level] : "?";
+}
+
+void shed_escalate(void) {
+    if (g_shed_level < SHED_RATE_MIN) {
+        g_shed_level++;
+    }
+    s_relax = 0;
+}
+
+shed_level_t shed_update(size_t free_heap) {
+    shed_level_t level = g_shed_level;
+
+    if (level == SHED_RATE_MIN) {
+        /* Último degrau reversível: reinicia só se continuar crítico */
+        s_critical = free_heap < SHED_REBOOT_BYTES ? s_critical + 1 : 0;
+        if (s_critical >= SHED_REBOOT_PERIODS) {
+            g_shed_level = SHED_REBOOT;
+            return SHED_REBOOT;
+        }
+    } else {
+        s_critical = 0;
+    }
+
+    if (level < SHED_RATE_MIN && free_heap < k_enter[level + 1]) {
+        g_shed_level = level + 1;
+        s_relax = 0;
+    } else if (level > SHED_NORMAL && free_heap > k_enter[level] + SHED_HYSTERESIS_BYTES) {
+        if (++s_relax >= SHED_RELAX_PERIODS) {
+            g_shed_level = level - 1;
+            s_relax = 0;
+        }
+    } else {
+        s_relax = 0;
+    }
+    return g_shed_level;
+}
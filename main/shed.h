@@ -0,0 +1,59 @@
+#pragma once
+
+/* ==========================
+ *  Degradação gradual por falta de memória (load shedding)
+ *  Escada avaliada pelo supervisor a cada período com o heap livre ATUAL
+ *  (o mínimo histórico nunca volta, então não serviria para desfazer):
+ *
+ *    SHED_NORMAL      operação normal
+ *    SHED_RATE_HALF   gerador na metade da taxa
+ *    SHED_NO_LOGGER   + task_logger encerrada (devolve a pilha ao heap)
+ *    SHED_RATE_MIN    + gerador a 1/8 da taxa
+ *    SHED_REBOOT      esp_restart() – só se nem o degrau anterior segurar
+ *
+ *  Sobe um degrau por período quando o heap cruza o limite de entrada;
+ *  desce um degrau depois de SHED_RELAX_PERIODS períodos acima do limite
+ *  de saída (entrada + histerese). Todos os degraus antes do reinício são
+ *  reversíveis.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SHED_NORMAL = 0,
+    SHED_RATE_HALF,
+    SHED_NO_LOGGER,
+    SHED_RATE_MIN,
+    SHED_REBOOT,
+    SHED_LEVEL_COUNT
+} shed_level_t;
+
+extern volatile shed_level_t g_shed_level;
+
+/* Avalia a escada com o heap livre atual; retorna o novo degrau */
+shed_level_t shed_update(size_t free_heap);
+/* Sobe um degrau sem esperar o limite (ex.: recriações seguidas da RX) */
+void shed_escalate(void);
+const char *shed_level_name(shed_level_t level);
+
+/* Fator da taxa do gerador: intervalo entre chegadas << shift */
+#define SHED_MAX_SLOW_SHIFT  3
+
+static inline uint32_t shed_gen_slow_shift(void) {
+    shed_level_t l = g_shed_level;
+    return l >= SHED_RATE_MIN ? SHED_MAX_SLOW_SHIFT : l >= SHED_RATE_HALF ? 1 : 0;
+}
+
+static inline bool shed_logger_enabled(void) {
+    return g_shed_level < SHED_NO_LOGGER;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "sink.h"
+#if APP_BUS
+#include "bus.h"
+#endif
+
+#if APP_SINKS
+
+/* Com APP_BUS cada sink é assinante de BUS_TOPIC_RECORD: a RX publica o
+ * registro uma vez e cada sink recebe só o handle. Sem o barramento, a RX
+ * copia o item para a fila de cada sink (sink_publish) */
+typedef struct {
+    const sink_t *sink;
+#if APP_BUS
+    bus_sub_t *sub;
+#else
+    QueueHandle_t buf;
+#endif
+    sink_stats_t stats;
+} sink_slot_t;
+
+static sink_slot_t s_sinks[SINK_MAX];
+static int s_n = 0;
+
+bool sink_register(const sink_t *sink) {
+    if (s_n >= SINK_MAX) {
+        return false;
+    }
+    s_sinks[s_n++].sink = sink;
+    return true;
+}
+
+/* ==========================
+ *  Tarefa de um sink: retira em lotes e escreve
+ * ========================== */
+static void task_sink(void *pv) {
+    sink_slot_t *s = (sink_slot_t *)pv;
+    pipe_item_t batch[SINK_BATCH];
+
+    for (;;) {
+        size_t n = 0;
+#if APP_BUS
+        /* Copia do buffer do barramento para o lote (fora da RX) e solta */
+        bus_msg_t *m = bus_receive(s->sub, portMAX_DELAY);
+        while (m) {
+            memcpy(&batch[n++], m->payload, sizeof(pipe_item_t));
+            bus_release(m);
+            m = n < SINK_BATCH ? bus_receive(s->sub, 0) : NULL;
+        }
+        if (n == 0) {
+            continue;
+        }
+#else
+        if (xQueueReceive(s->buf, &batch[0], portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        for (n = 1; n < SINK_BATCH && xQueueReceive(s->buf, &batch[n], 0) == pdTRUE; n++) {
+        }
+#endif
+
+        size_t ok = s->sink->write(s->sink->ctx, batch, n);
+        s->stats.written += ok;
+        s->stats.failed += n - ok;
+
+        /* Lag do lote = item mais antigo (o primeiro retirado) */
+        uint32_t lag = metrics_now_us() - batch[0].t_enq_us;
+        s->stats.lag_us = lag;
+        if (lag > s->stats.lag_max_us) {
+            s->stats.lag_max_us = lag;
+        }
+    }
+}
+
+bool sink_start(void) {
+    for (int i = 0; i < s_n; i++) {
+        sink_slot_t *s = &s_sinks[i];
+        if (s->sink->open && !s->sink->open(s->sink->ctx)) {
+            PRINTF("[SINK] Aviso: %s não abriu – desativado.\n", s->sink->name);
+            continue;
+        }
+#if APP_BUS
+        s->sub = bus_subscribe(BUS_TOPIC_RECORD, s->sink->name, SINK_BUF_LEN,
+                               s->sink->policy == SINK_DROP_OLDEST);
+        if (!s->sub ||
+#else
+        s->buf = xQueueCreate(SINK_BUF_LEN, sizeof(pipe_item_t));
+        if (!s->buf ||
+#endif
+            xTaskCreatePinnedToCore(task_sink, s->sink->name, SINK_STACK_WORDS, s,
+                                    SINK_TASK_PRIO, NULL, APP_PIPE_CORE) != pdPASS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if !APP_BUS
+void sink_publish(const pipe_item_t *item) {
+    for (int i = 0; i < s_n; i++) {
+        sink_slot_t *s = &s_sinks[i];
+        if (!s->buf) {
+            continue;
+        }
+        if (xQueueSend(s->buf, item, 0) == pdTRUE) {
+            continue;
+        }
+        /* Buffer cheio: o prejuízo fica com este sink */
+        s->stats.dropped++;
+        if (s->sink->policy == SINK_DROP_OLDEST) {
+            pipe_item_t old;
+            xQueueReceive(s->buf, &old, 0);
+            /* A tarefa do sink pode não ter liberado a vaga (retirada vazia
+             * ou corrida): se o reenvio falhar, o novo também se perde */
+            if (xQueueSend(s->buf, item, 0) != pdTRUE) {
+                s->stats.dropped++;
+            }
+        }
+    }
+}
+
+#endif // !APP_BUS
+
+int sink_count(void) {
+    return s_n;
+}
+
+const char *sink_name(int i) {
+    return s_sinks[i].sink->name;
+}
+
+void sink_get_stats(int i, sink_stats_t *out, uint32_t *queued) {
+    const sink_slot_t *s = &s_sinks[i];
+    out->written = s->stats.written;
+    out->failed = s->stats.failed;
+    out->lag_us = s->stats.lag_us;
+    out->lag_max_us = s->stats.lag_max_us;
+#if APP_BUS
+    out->dropped = s->sub ? s->sub->dropped : 0;   // descarte acontece no bus_publish
+    *queued = s->sub ? uxQueueMessagesWaiting(s->sub->q) : 0;
+#else
+    out->dropped = s->stats.dropped;
+    *queued = s->buf ? uxQueueMessagesWaiting(s->buf) : 0;
+#endif
+}
+
+#endif // APP_SINKS
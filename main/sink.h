@@ -0,0 +1,71 @@
+#pragma once
+
+/* ==========================
+ *  Saídas plugáveis da RX (APP_SINKS)
+ *  A RX publica cada item uma vez e segue: com APP_BUS no barramento
+ *  (cada sink assina BUS_TOPIC_RECORD e recebe só o handle), sem ele
+ *  por sink_publish (cópia na fila de cada sink). Cada sink registrado
+ *  tem seu próprio buffer limitado e sua própria tarefa, que retira em
+ *  lotes e chama write(). Um sink lento ou travado só enche o próprio
+ *  buffer e, cheio, descarta conforme sua política; a RX e os outros
+ *  sinks não esperam por ele.
+ *
+ *  Por sink: itens escritos, descartados, fila e atraso (lag) entre o
+ *  enfileiramento na pipeline e a escrita.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "app_config.h"
+#include "pipe_channel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SINK_MAX          4
+#define SINK_BATCH        8    // itens por write()
+
+typedef enum {
+    SINK_DROP_NEWEST = 0,      // buffer cheio: descarta o que chega
+    SINK_DROP_OLDEST,          // buffer cheio: descarta o mais antigo (dado fresco vale mais)
+} sink_policy_t;
+
+typedef struct {
+    const char *name;
+    sink_policy_t policy;
+    bool (*open)(void *ctx);                                       // opcional
+    /* Escreve n itens; devolve quantos foram aceitos (o resto é perdido) */
+    size_t (*write)(void *ctx, const pipe_item_t *items, size_t n);
+    void *ctx;
+} sink_t;
+
+typedef struct {
+    volatile uint32_t written;   // escritor: tarefa do sink
+    volatile uint32_t failed;    // escritor: tarefa do sink (write recusou)
+    volatile uint32_t dropped;   // escritor: sink_publish / bus_publish (buffer cheio)
+    volatile uint32_t lag_us;    // último atraso enfileiramento → escrita
+    volatile uint32_t lag_max_us;
+} sink_stats_t;
+
+/* Antes de sink_start; `sink` precisa viver para sempre */
+bool sink_register(const sink_t *sink);
+/* Cria buffers e tarefas dos sinks registrados */
+bool sink_start(void);
+#if !APP_BUS
+/* Entrega o item a todos os sinks sem bloquear (chamado pela RX) */
+void sink_publish(const pipe_item_t *item);
+#endif
+
+int  sink_count(void);
+const char *sink_name(int i);
+void sink_get_stats(int i, sink_stats_t *out, uint32_t *queued);
+
+/* Sinks embutidos (sinks.c): console, flash e rede */
+void sinks_register_builtin(void);
+
+#ifdef __cplusplus
+}
+#endif
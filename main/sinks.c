@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "sink.h"
+
+#if APP_SINKS
+
+/* ==========================
+ *  PARÂMETROS DOS SINKS SIMULADOS
+ *  Flash e rede não têm hardware nesta placa: simulam o custo de escrita
+ *  e as travadas de cada meio, que é o que importa para o isolamento.
+ * ========================== */
+#define FLASH_PAGE_BYTES        256
+#define FLASH_PROGRAM_MS        20     // programar uma página
+#define NET_SEND_MS             10     // enviar um lote
+#define NET_OUTAGE_EVERY_MS     15000  // queda de enlace periódica...
+#define NET_OUTAGE_MS           4000   // ...com esta duração (envio travado)
+
+/* ==========================
+ *  Console – a "transmissão" original
+ * ========================== */
+static size_t console_write(void *ctx, const pipe_item_t *items, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        PRINTF("[RX] Transmitindo valor: %d\n", (int)items[i].value);
+    }
+    return n;
+}
+
+static const sink_t k_console = {
+    .name = "sink_console",
+    .policy = SINK_DROP_NEWEST,
+    .write = console_write,
+};
+
+/* ==========================
+ *  Flash – acumula registros numa página e programa quando enche
+ * ========================== */
+typedef struct {
+    uint8_t page[FLASH_PAGE_BYTES];
+    size_t used;
+    uint32_t pages;
+} flash_ctx_t;
+
+static flash_ctx_t s_flash;
+
+static size_t flash_write(void *ctx, const pipe_item_t *items, size_t n) {
+    flash_ctx_t *f = (flash_ctx_t *)ctx;
+    for (size_t i = 0; i < n; i++) {
+        memcpy(&f->page[f->used], &items[i], sizeof(pipe_item_t));
+        f->used += sizeof(pipe_item_t);
+        if (f->used + sizeof(pipe_item_t) > FLASH_PAGE_BYTES) {
+            vTaskDelay(pdMS_TO_TICKS(FLASH_PROGRAM_MS));
+            f->pages++;
+            f->used = 0;
+        }
+    }
+    return n;
+}
+
+static const sink_t k_flash = {
+    .name = "sink_flash",
+    .policy = SINK_DROP_NEWEST,
+    .write = flash_write,
+    .ctx = &s_flash,
+};
+
+/* ==========================
+ *  Rede – envio por lote; enlace cai periodicamente e o envio trava.
+ *  Descarta o mais antigo: do outro lado interessa o dado recente.
+ * ========================== */
+static size_t net_write(void *ctx, const pipe_item_t *items, size_t n) {
+    int64_t phase_ms = (esp_timer_get_time() / 1000) % NET_OUTAGE_EVERY_MS;
+    if (phase_ms >= NET_OUTAGE_EVERY_MS - NET_OUTAGE_MS) {
+        vTaskDelay(pdMS_TO_TICKS(NET_OUTAGE_EVERY_MS - phase_ms));   // preso até o enlace voltar
+    }
+    vTaskDelay(pdMS_TO_TICKS(NET_SEND_MS));
+    return n;
+}
+
+static const sink_t k_net = {
+    .name = "sink_net",
+    .policy = SINK_DROP_OLDEST,
+    .write = net_write,
+};
+
+void sinks_register_builtin(void) {
+    sink_register(&k_console);
+    sink_register(&k_flash);
+    sink_register(&k_net);
+}
+
+#endif // APP_SINKS
@@ -0,0 +1,193 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+
+#include "app_config.h"
+#include "metrics.h"
+#include "soak.h"
+
+/* ==========================
+ *  PARÂMETROS DO SOAK
+ * ========================== */
+#define SOAK_DURATION_S        (6 * 3600)  // duração total
+#define SOAK_SAMPLE_MS         10000       // período de amostragem
+#define SOAK_WARMUP_SAMPLES    6           // descartadas (boot, fila enchendo)
+#define SOAK_MIN_SAMPLES       30          // mínimo para avaliar tendência
+#define SOAK_TASK_PRIO         3
+#define SOAK_STACK_WORDS       4096
+
+typedef enum {
+    SOAK_THROUGHPUT = 0,
+    SOAK_LAT_P50,
+    SOAK_LAT_P95,
+    SOAK_LAT_P99,
+    SOAK_HEAP_FREE,
+    SOAK_HEAP_MIN,
+    SOAK_HEAP_LARGEST,
+    SOAK_STACK_MIN,
+    SOAK_RESTARTS,
+    SOAK_METRIC_COUNT
+} soak_metric_t;
+
+/* Limite de inclinação por hora; bad_sign diz qual direção é degradação */
+typedef struct {
+    const char *name;
+    const char *unit;
+    double max_slope_per_h;
+    int bad_sign;
+} soak_limit_t;
+
+static const soak_limit_t k_limits[SOAK_METRIC_COUNT] = {
+    [SOAK_THROUGHPUT]   = { "throughput",  "itens/s", 0.10,  -1 },
+    [SOAK_LAT_P50]      = { "lat_p50",     "us",      500.0, +1 },
+    [SOAK_LAT_P95]      = { "lat_p95",     "us",      1000.0, +1 },
+    [SOAK_LAT_P99]      = { "lat_p99",     "us",      2000.0, +1 },
+    [SOAK_HEAP_FREE]    = { "heap_free",   "B",       256.0, -1 },
+    [SOAK_HEAP_MIN]     = { "heap_min",    "B",       256.0, -1 },
+    [SOAK_HEAP_LARGEST] = { "heap_larg",   "B",       512.0, -1 },
+    [SOAK_STACK_MIN]    = { "stack_min",   "words",   4.0,   -1 },
+    [SOAK_RESTARTS]     = { "restarts",    "",        0.5,   +1 },
+};
+
+/* Regressão linear incremental: x em horas desde o fim do aquecimento */
+typedef struct {
+    double n, sx, sy, sxx, sxy;
+} trend_t;
+
+static trend_t s_trend[SOAK_METRIC_COUNT];
+
+static void trend_add(trend_t *t, double x, double y) {
+    t->n += 1;
+    t->sx += x;
+    t->sy += y;
+    t->sxx += x * x;
+    t->sxy += x * y;
+}
+
+static double trend_slope(const trend_t *t) {
+    double den = t->n * t->sxx - t->sx * t->sx;
+    return den != 0.0 ? (t->n * t->sxy - t->sx * t->sy) / den : 0.0;
+}
+
+static uint32_t stack_min_all(void) {
+    uint32_t m = UINT32_MAX;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (g_metrics.stack_min_words[i] < m) {
+            m = g_metrics.stack_min_words[i];
+        }
+    }
+    return m == UINT32_MAX ? 0 : m;
+}
+
+static uint32_t restarts_all(void) {
+    uint32_t r = 0;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        r += g_metrics.restarts[i];
+    }
+    return r;
+}
+
+static void soak_finish(bool failed) {
+    PRINTF("[SOAK] RESULTADO: %s\n", failed ? "FALHOU" : "PASSOU");
+    for (int m = 0; m < SOAK_METRIC_COUNT; m++) {
+        PRINTF("[SOAK]   %-10s tendência %+.3f %s/h (limite %.3f)\n",
+               k_limits[m].name, trend_slope(&s_trend[m]), k_limits[m].unit,
+               k_limits[m].max_slope_per_h);
+    }
+#if CONFIG_IDF_TARGET_LINUX
+    fflush(stdout);
+    exit(failed ? 1 : 0);
+#endif
+}
+
+static void task_soak(void *pv) {
+    /* Estáticos: 1,5 KB cada, fora da pilha */
+    static lat_hist_t window;        // janela de latência (diferença entre amostras)
+    static lat_hist_t prev_total;
+    static lat_hist_t total;
+
+    const int64_t t_start = esp_timer_get_time();
+    int64_t t_prev = t_start;
+    uint32_t consumed_prev = g_metrics.consumed;
+    uint32_t samples = 0;
+    bool failed = false;
+
+    prev_total = g_metrics.latency;
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(SOAK_SAMPLE_MS));
+
+        int64_t now = esp_timer_get_time();
+        double dt_s = (double)(now - t_prev) / 1e6;
+        t_prev = now;
+
+        /* Latência da janela = histograma total atual − total anterior */
+        total = g_metrics.latency;
+        window.count = total.count - prev_total.count;
+        window.max_us = total.max_us;
+        for (uint32_t i = 0; i < LAT_HIST_BUCKETS; i++) {
+            window.bucket[i] = total.bucket[i] - prev_total.bucket[i];
+        }
+        prev_total = total;
+
+        uint32_t consumed = g_metrics.consumed;
+        double v[SOAK_METRIC_COUNT];
+        v[SOAK_THROUGHPUT]   = dt_s > 0 ? (double)(consumed - consumed_prev) / dt_s : 0;
+        v[SOAK_LAT_P50]      = lat_hist_percentile(&window, 50);
+        v[SOAK_LAT_P95]      = lat_hist_percentile(&window, 95);
+        v[SOAK_LAT_P99]      = lat_hist_percentile(&window, 99);
+        v[SOAK_HEAP_FREE]    = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+        v[SOAK_HEAP_MIN]     = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+        v[SOAK_HEAP_LARGEST] = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+        v[SOAK_STACK_MIN]    = stack_min_all();
+        v[SOAK_RESTARTS]     = restarts_all();
+        consumed_prev = consumed;
+
+        double t_h = (double)(now - t_start) / 3600e6;
+        PRINTF("[SOAK] t=%.0fs thr=%.2f p50=%.0f p95=%.0f p99=%.0f heap=%.0f min=%.0f larg=%.0f "
+               "stack=%.0f restarts=%.0f\n",
+               t_h * 3600, v[SOAK_THROUGHPUT], v[SOAK_LAT_P50], v[SOAK_LAT_P95], v[SOAK_LAT_P99],
+               v[SOAK_HEAP_FREE], v[SOAK_HEAP_MIN], v[SOAK_HEAP_LARGEST],
+               v[SOAK_STACK_MIN], v[SOAK_RESTARTS]);
+
+        if (++samples <= SOAK_WARMUP_SAMPLES) {
+            continue;
+        }
+        for (int m = 0; m < SOAK_METRIC_COUNT; m++) {
+            trend_add(&s_trend[m], t_h, v[m]);
+        }
+
+        /* Avalia a tendência a cada amostra depois do mínimo */
+        if (samples - SOAK_WARMUP_SAMPLES >= SOAK_MIN_SAMPLES) {
+            for (int m = 0; m < SOAK_METRIC_COUNT; m++) {
+                double slope = trend_slope(&s_trend[m]) * k_limits[m].bad_sign;
+                if (slope > k_limits[m].max_slope_per_h) {
+                    PRINTF("[SOAK] FALHA: %s degradando %.3f %s/h (limite %.3f).\n",
+                           k_limits[m].name, slope, k_limits[m].unit, k_limits[m].max_slope_per_h);
+                    failed = true;
+                }
+            }
+        }
+
+        if (failed || now - t_start >= (int64_t)SOAK_DURATION_S * 1000000) {
+            break;
+        }
+    }
+
+    soak_finish(failed);
+    vTaskDelete(NULL);
+}
+
+void soak_start(void) {
+    PRINTF("[SOAK] Iniciando soak de %u s (amostra a cada %u ms).\n",
+           (unsigned)SOAK_DURATION_S, (unsigned)SOAK_SAMPLE_MS);
+    xTaskCreatePinnedToCore(task_soak, "task_soak", SOAK_STACK_WORDS, NULL,
+                            SOAK_TASK_PRIO, NULL, 0);
+}
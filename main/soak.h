@@ -0,0 +1,22 @@
+#pragma once
+
+/* ==========================
+ *  Soak (modo APP_MODE_SOAK)
+ *  Roda a pipeline normal por SOAK_DURATION_S (tempo real, QEMU ou tempo
+ *  virtual no target linux) e amostra periodicamente vazão, percentis de
+ *  latência, heap (livre, mínimo, maior bloco), marca d'água de pilha e
+ *  recriações de tarefas. A tendência de cada métrica (regressão linear,
+ *  unidade/hora) é comparada com um limite; passou do limite → FALHA.
+ *  No target linux o processo termina com código 0 (passou) ou 1 (falhou).
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Inicia a tarefa de amostragem. Chamar depois de criar a pipeline. */
+void soak_start(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,174 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+#include "esp_timer.h"
+#include "esp_cpu.h"
+
+#include "app_config.h"
+#include "pipe_channel.h"
+#include "stress.h"
+
+#if APP_MODE_STRESS
+
+/* ==========================
+ *  PARÂMETROS DO STRESS
+ * ========================== */
+#define STRESS_PHASE_MS        2000   // janela de medição por profundidade (< WDT)
+#define STRESS_SETTLE_MS       200    // folga entre fases (drena fila, idle roda)
+#define STRESS_CTRL_PRIO       (GEN_TASK_PRIO + 1)
+
+/* Com 2 núcleos a RX vai para o outro núcleo: a fonte ocupa o núcleo 1
+ * inteiro durante a fase e os dois estágios rodam de fato em paralelo. */
+#if APP_NUM_CORES > 1
+#define STRESS_GEN_CORE        1
+#else
+#define STRESS_GEN_CORE        0
+#endif
+#define STRESS_RX_CORE         0
+
+static const size_t k_depths[] = { 1, 2, 4, 8, 16, 32, STRESS_MAX_DEPTH };
+
+#define RUN_BIT  (1u << 0)
+
+/* Contadores: cada um tem um único escritor; lidos pelo controle com a
+ * pipeline parada (fim de fase). */
+typedef struct {
+    volatile uint32_t sent;
+    volatile uint32_t dropped;
+    volatile uint32_t received;
+    volatile uint64_t gen_cycles;
+    volatile uint64_t rx_cycles;
+} stress_counters_t;
+
+static stress_counters_t s_cnt;
+static EventGroupHandle_t s_ev = NULL;
+static volatile bool s_running = false;
+
+/* ==========================
+ *  Fonte – gera sem atraso; descarta se a fila (limitada) estiver cheia.
+ *  Mesma prioridade da RX para que, em núcleo único, o taskYIELD() no
+ *  descarte ceda a CPU ao consumidor.
+ * ========================== */
+static void stress_generator(void *pv) {
+    pipe_item_t item = { 0 };
+    for (;;) {
+        if (!s_running) {
+            xEventGroupWaitBits(s_ev, RUN_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        }
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        bool ok = pipe_send(&item, 0);
+        s_cnt.gen_cycles += esp_cpu_get_cycle_count() - c0;
+        item.value++;
+        if (ok) {
+            s_cnt.sent++;
+        } else {
+            s_cnt.dropped++;
+            taskYIELD();
+        }
+    }
+}
+
+/* ==========================
+ *  Receptor – mesmo processamento da RX normal (malloc/cópia/free), sem o
+ *  print por item e sem a folga de 50 ms. Só conta ciclos de trabalho:
+ *  o tempo bloqueado esperando dado fica de fora.
+ * ========================== */
+static void stress_receiver(void *pv) {
+    for (;;) {
+        pipe_item_t rx_val;
+        uint32_t c0 = esp_cpu_get_cycle_count();
+        if (!pipe_receive(&rx_val, 0)) {
+            if (!pipe_receive(&rx_val, pdMS_TO_TICKS(100))) {
+                continue;
+            }
+            c0 = esp_cpu_get_cycle_count();
+        }
+
+        int *tmp = (int*) malloc(sizeof(int));
+        if (tmp) {
+            *tmp = rx_val.value;
+            free(tmp);
+        }
+
+        s_cnt.rx_cycles += esp_cpu_get_cycle_count() - c0;
+        s_cnt.received++;
+    }
+}
+
+/* ==========================
+ *  Controle da varredura
+ * ========================== */
+void stress_run(void) {
+    s_ev = xEventGroupCreate();
+    if (!s_ev) {
+        PRINTF("[STRESS] ERRO: falha ao criar event group.\n");
+        return;
+    }
+
+    /* Controle acima da pipeline para conseguir encerrar cada fase no prazo */
+    vTaskPrioritySet(NULL, STRESS_CTRL_PRIO);
+
+    xTaskCreatePinnedToCore(stress_receiver, "stress_rx", RX_STACK_WORDS, NULL,
+                            RX_TASK_PRIO, NULL, STRESS_RX_CORE);
+    xTaskCreatePinnedToCore(stress_generator, "stress_gen", GEN_STACK_WORDS, NULL,
+                            RX_TASK_PRIO, NULL, STRESS_GEN_CORE);
+
+    PRINTF("[STRESS] Varredura: %u ms por fase, GEN no núcleo %d, RX no núcleo %d.\n",
+           (unsigned)STRESS_PHASE_MS, STRESS_GEN_CORE, STRESS_RX_CORE);
+    PRINTF("[STRESS] %6s %10s %10s %10s %8s %12s %10s\n",
+           "depth", "enviados", "descartes", "itens/s", "desc%", "ciclos/item", "ns/item");
+
+    uint32_t best_ips = 0;
+    size_t best_depth = 0;
+
+    for (size_t i = 0; i < sizeof(k_depths) / sizeof(k_depths[0]); i++) {
+        size_t depth = k_depths[i];
+
+        pipe_reset();
+        pipe_set_depth_limit(depth);
+        s_cnt = (stress_counters_t){ 0 };
+
+        int64_t t0 = esp_timer_get_time();
+        s_running = true;
+        xEventGroupSetBits(s_ev, RUN_BIT);
+
+        vTaskDelay(pdMS_TO_TICKS(STRESS_PHASE_MS));
+
+        xEventGroupClearBits(s_ev, RUN_BIT);
+        s_running = false;
+        int64_t t1 = esp_timer_get_time();
+        uint32_t received_in_window = s_cnt.received;
+
+        /* Deixa a RX drenar o que sobrou e o idle alimentar o WDT */
+        vTaskDelay(pdMS_TO_TICKS(STRESS_SETTLE_MS));
+
+        uint32_t offered = s_cnt.sent + s_cnt.dropped;
+        uint32_t ips = (uint32_t)((int64_t)received_in_window * 1000000 / (t1 - t0));
+        uint32_t drop_x100 = offered ? (uint32_t)((uint64_t)s_cnt.dropped * 10000 / offered) : 0;
+        uint32_t cyc = s_cnt.received
+                     ? (uint32_t)((s_cnt.gen_cycles + s_cnt.rx_cycles) / s_cnt.received) : 0;
+        uint32_t ns = cyc * 1000 / APP_CPU_FREQ_MHZ;
+
+        PRINTF("[STRESS] %6u %10" PRIu32 " %10" PRIu32 " %10" PRIu32 " %5" PRIu32 ".%02" PRIu32
+               " %12" PRIu32 " %10" PRIu32 "\n",
+               (unsigned)depth, s_cnt.sent, s_cnt.dropped, ips,
+               drop_x100 / 100, drop_x100 % 100, cyc, ns);
+
+        if (ips > best_ips) {
+            best_ips = ips;
+            best_depth = depth;
+        }
+    }
+
+    pipe_set_depth_limit(PIPE_CAPACITY);
+    PRINTF("[STRESS] Capacidade sustentada: %" PRIu32 " itens/s (profundidade %u).\n",
+           best_ips, (unsigned)best_depth);
+}
+
+#endif // APP_MODE_STRESS
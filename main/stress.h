@@ -0,0 +1,22 @@
+#pragma once
+
+/* ==========================
+ *  Modo stress (APP_MODE_STRESS)
+ *  Pipeline GERADOR→RX sem atrasos artificiais e sem print por item: a
+ *  fonte gera o mais rápido possível e, para cada profundidade de fila da
+ *  varredura, mede durante uma janela fixa:
+ *    - itens/s sustentados no receptor
+ *    - taxa de descarte na fonte (fila cheia)
+ *    - ciclos de CPU por item (trabalho de GERADOR + RX, sem bloqueios)
+ * ========================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cria as tarefas de stress e executa a varredura (bloqueante). */
+void stress_run(void);
+
+#ifdef __cplusplus
+}
+#endif
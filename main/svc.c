@@ -0,0 +1,86 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+
+#include "app_config.h"
+#include "svc.h"
+
+#if APP_SERVICE_TIMERS
+
+/* ==========================
+ *  PARÂMETROS DO SERVIÇO
+ * ========================== */
+#define SVC_QUEUE_LEN        8
+#define SVC_MAX_TIMERS       4
+
+typedef struct {
+    svc_fn_t fn;
+    uint32_t arg;
+} svc_job_t;
+
+static QueueHandle_t s_jobs = NULL;
+static svc_job_t s_timer_jobs[SVC_MAX_TIMERS];
+static uint32_t s_n_timers = 0;
+static volatile uint32_t s_dropped = 0;
+
+bool svc_defer(svc_fn_t fn, uint32_t arg) {
+    svc_job_t job = { .fn = fn, .arg = arg };
+    if (!s_jobs || xQueueSend(s_jobs, &job, 0) != pdTRUE) {
+        s_dropped++;
+        return false;
+    }
+    return true;
+}
+
+uint32_t svc_dropped(void) {
+    return s_dropped;
+}
+
+/* Roda no daemon de timers: só adia */
+static void svc_timer_cb(TimerHandle_t t) {
+    const svc_job_t *job = (const svc_job_t *)pvTimerGetTimerID(t);
+    svc_defer(job->fn, job->arg);
+}
+
+bool svc_every(const char *name, uint32_t period_ms, svc_fn_t fn, uint32_t arg) {
+    if (s_n_timers >= SVC_MAX_TIMERS) {
+        return false;
+    }
+    svc_job_t *job = &s_timer_jobs[s_n_timers];
+    job->fn = fn;
+    job->arg = arg;
+    TimerHandle_t t = xTimerCreate(name, pdMS_TO_TICKS(period_ms), pdTRUE, job, svc_timer_cb);
+    if (!t) {
+        return false;
+    }
+    if (xTimerStart(t, portMAX_DELAY) != pdPASS) {
+        xTimerDelete(t, 0);   // nunca iniciou: não fica órfão
+        return false;
+    }
+    s_n_timers++;
+    return true;
+}
+
+static void task_service(void *pv) {
+    svc_job_t job;
+    for (;;) {
+        if (xQueueReceive(s_jobs, &job, portMAX_DELAY) == pdTRUE) {
+            job.fn(job.arg);
+        }
+    }
+}
+
+bool svc_start(void) {
+    s_jobs = xQueueCreate(SVC_QUEUE_LEN, sizeof(svc_job_t));
+    if (!s_jobs) {
+        return false;
+    }
+    return xTaskCreatePinnedToCore(task_service, "task_service", SVC_STACK_WORDS, NULL,
+                                   SUP_TASK_PRIO, NULL, APP_PIPE_CORE) == pdPASS;
+}
+
+#endif // APP_SERVICE_TIMERS
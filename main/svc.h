@@ -0,0 +1,38 @@
+#pragma once
+
+/* ==========================
+ *  Serviços periódicos sem tarefa própria (APP_SERVICE_TIMERS)
+ *  Supervisor e logger passam a ser timers de software FreeRTOS. O
+ *  callback do timer não faz trabalho: só enfileira o job numa fila de
+ *  trabalho adiado, e uma única tarefa de serviço executa os jobs em
+ *  ordem. O daemon de timers nunca fica bloqueado em printf, criação de
+ *  tarefas ou heap; e duas pilhas + dois TCBs viram uma pilha + um TCB.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*svc_fn_t)(uint32_t arg);
+
+/* Cria a fila de trabalho e a tarefa de serviço */
+bool svc_start(void);
+
+/* Enfileira fn(arg) sem bloquear (tarefa, timer ou esp_timer).
+ * Retorna false se a fila estiver cheia (job descartado e contado). */
+bool svc_defer(svc_fn_t fn, uint32_t arg);
+
+/* Timer periódico que adia fn(arg) a cada período */
+bool svc_every(const char *name, uint32_t period_ms, svc_fn_t fn, uint32_t arg);
+
+/* Jobs descartados por fila cheia */
+uint32_t svc_dropped(void);
+
+#ifdef __cplusplus
+}
+#endif
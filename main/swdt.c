@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "swdt.h"
+
+#if APP_SWDT
+
+static const char *const k_stage_names[STAGE_COUNT] = {
+    [STAGE_GEN] = "GERADOR",
+    [STAGE_RX]  = "RX",
+    [STAGE_SUP] = "SUP",
+    [STAGE_LOG] = "LOG",
+};
+
+portMUX_TYPE g_swdt_lock = portMUX_INITIALIZER_UNLOCKED;
+volatile uint32_t g_swdt_deadline_us[STAGE_COUNT];
+volatile bool g_swdt_armed[STAGE_COUNT];
+
+static uint32_t s_actions[STAGE_COUNT];
+static swdt_notify_fn_t s_notify = NULL;
+static esp_timer_handle_t s_timer = NULL;
+
+void swdt_configure(stage_id_t stage, uint32_t actions) {
+    s_actions[stage] = actions;
+}
+
+void swdt_set_notify(swdt_notify_fn_t fn) {
+    s_notify = fn;
+}
+
+void swdt_disarm(stage_id_t stage) {
+    portENTER_CRITICAL(&g_swdt_lock);
+    g_swdt_armed[stage] = false;
+    portEXIT_CRITICAL(&g_swdt_lock);
+}
+
+/* Roda na tarefa do esp_timer: pode imprimir e notificar */
+static void swdt_check(void *arg) {
+    uint32_t now = metrics_now_us();
+    uint32_t notify = 0;
+
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        /* Teste e desarme atômicos: um expect concorrente vence ou perde inteiro */
+        portENTER_CRITICAL(&g_swdt_lock);
+        uint32_t deadline = g_swdt_deadline_us[i];
+        bool missed = g_swdt_armed[i] && (int32_t)(now - deadline) >= 0;
+        if (missed) {
+            g_swdt_armed[i] = false;   // uma ação por prazo perdido; o próximo expect rearma
+        }
+        portEXIT_CRITICAL(&g_swdt_lock);
+        if (!missed) {
+            continue;
+        }
+        uint32_t act = s_actions[i];
+
+        if (act & SWDT_ACT_LOG) {
+            PRINTF("[SWDT] %s perdeu o prazo (%u ms de atraso).\n", k_stage_names[i],
+                   (unsigned)((now - deadline) / 1000));
+        }
+        if (act & SWDT_ACT_PANIC) {
+            PRINTF("[SWDT] %s: ação de pânico.\n", k_stage_names[i]);
+            fflush(stdout);
+            abort();
+        }
+        if (act & SWDT_ACT_NOTIFY) {
+            notify |= SWDT_NOTIFY_BIT(i);
+        }
+        if (act & SWDT_ACT_RESTART) {
+            notify |= SWDT_RESTART_BIT(i);
+        }
+    }
+
+    if (notify && s_notify) {
+        s_notify(notify);
+    }
+}
+
+bool swdt_start(void) {
+    const esp_timer_create_args_t args = {
+        .callback = swdt_check,
+        .name = "swdt",
+    };
+    if (esp_timer_create(&args, &s_timer) != ESP_OK) {
+        return false;
+    }
+    return esp_timer_start_periodic(s_timer, SWDT_CHECK_MS * 1000) == ESP_OK;
+}
+
+#endif // APP_SWDT
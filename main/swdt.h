@@ -0,0 +1,84 @@
+#pragma once
+
+/* ==========================
+ *  Watchdog de software por estágio
+ *  Cada estágio declara, a cada volta, quando deve voltar (swdt_expect com
+ *  a espera prevista: período do perfil de tráfego, timeout da RX...).
+ *  O prazo é essa espera + SWDT_SLACK_PCT% + SWDT_MIN_SLACK_MS, então a
+ *  latência de detecção acompanha o período do próprio estágio, e não os
+ *  WDT_TIMEOUT_SECONDS globais do Task WDT.
+ *
+ *  Um esp_timer periódico (SWDT_CHECK_MS) verifica os prazos e executa as
+ *  ações configuradas do estágio, uma vez por prazo perdido:
+ *    SWDT_ACT_LOG      imprime o atraso
+ *    SWDT_ACT_NOTIFY   notifica o supervisor (bit do estágio)
+ *    SWDT_ACT_RESTART  pede ao supervisor para recriar a tarefa (cooperativo:
+ *                      a tarefa sai no início da volta e então é recriada)
+ *    SWDT_ACT_PANIC    abort() → pânico/reinício
+ *  Quem recria é sempre o supervisor (único dono dos handles); a entrega
+ *  dos bits é feita pela função registrada em swdt_set_notify (notificação
+ *  de tarefa ou job adiado, conforme o supervisor seja tarefa ou timer).
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SWDT_ACT_LOG       (1u << 0)
+#define SWDT_ACT_NOTIFY    (1u << 1)
+#define SWDT_ACT_RESTART   (1u << 2)
+#define SWDT_ACT_PANIC     (1u << 3)
+
+typedef void (*swdt_notify_fn_t)(uint32_t bits);
+
+/* Bits entregues ao supervisor */
+#define SWDT_NOTIFY_BIT(stage)    (1u << (stage))
+#define SWDT_RESTART_BIT(stage)   (1u << ((stage) + 8))
+
+#if APP_SWDT
+
+/* Prazo absoluto (µs de metrics_now_us); um escritor por estágio. A trava
+ * cobre prazo + armado juntos: o verificador desarma sem apagar um
+ * rearme feito no mesmo instante pelo estágio (outro núcleo) */
+extern portMUX_TYPE g_swdt_lock;
+extern volatile uint32_t g_swdt_deadline_us[STAGE_COUNT];
+extern volatile bool g_swdt_armed[STAGE_COUNT];
+
+/* Ações do estágio (SWDT_ACT_*) e quem recebe NOTIFY/RESTART */
+void swdt_configure(stage_id_t stage, uint32_t actions);
+void swdt_set_notify(swdt_notify_fn_t fn);
+bool swdt_start(void);
+/* Para de vigiar o estágio (saída intencional da tarefa) */
+void swdt_disarm(stage_id_t stage);
+
+/* "Volto em até wait_us": arma o prazo com a folga proporcional */
+static inline void swdt_expect(stage_id_t stage, uint32_t wait_us) {
+    uint32_t slack = wait_us / 100 * SWDT_SLACK_PCT + SWDT_MIN_SLACK_MS * 1000;
+    uint32_t deadline = metrics_now_us() + wait_us + slack;
+    portENTER_CRITICAL(&g_swdt_lock);
+    g_swdt_deadline_us[stage] = deadline;
+    g_swdt_armed[stage] = true;
+    portEXIT_CRITICAL(&g_swdt_lock);
+}
+
+#else
+
+static inline void swdt_configure(stage_id_t stage, uint32_t actions) { (void)stage; (void)actions; }
+static inline void swdt_set_notify(swdt_notify_fn_t fn) { (void)fn; }
+static inline bool swdt_start(void) { return true; }
+static inline void swdt_disarm(stage_id_t stage) { (void)stage; }
+static inline void swdt_expect(stage_id_t stage, uint32_t wait_us) { (void)stage; (void)wait_us; }
+
+#endif // APP_SWDT
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,154 @@
+#include <math.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+#include "app_config.h"
+#include "traffic.h"
+
+#define TRAFFIC_MAX_BURST       32        // chegadas por tick antes de ceder o núcleo
+#define TRAFFIC_MAX_LAG_US      1000000   // atraso maior que isso é descartado
+#define TRAFFIC_MIN_RATE_HZ     0.01f
+#define TICK_US                 (1000000 / configTICK_RATE_HZ)
+
+void traffic_default_cfg(traffic_cfg_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->profile = APP_TRAFFIC_PROFILE;
+    cfg->seed = APP_TRAFFIC_SEED;
+    cfg->rate_hz = 1000.0f / GEN_PERIOD_MS;
+
+    /* on/off: silêncio abaixo do limiar de falha da RX (rx_rto.c confere) */
+    cfg->on_ms = TRAFFIC_BURST_ON_MS;
+    cfg->off_ms = TRAFFIC_BURST_OFF_MS;
+
+    cfg->amplitude_hz = cfg->rate_hz * 0.8f;
+    cfg->period_s = 600;
+
+    static const traffic_step_t k_steps[] = {
+        { 30000, 1000.0f / GEN_PERIOD_MS },
+        { 30000, 20.0f },
+        { 30000, 2.0f },
+    };
+    cfg->n_steps = sizeof(k_steps) / sizeof(k_steps[0]);
+    memcpy(cfg->steps, k_steps, sizeof(k_steps));
+}
+
+void traffic_init(traffic_t *t, const traffic_cfg_t *cfg) {
+    t->cfg = *cfg;
+    t->rng = cfg->seed ? cfg->seed : 0x9E3779B9u;
+    t->t0_us = esp_timer_get_time();
+    t->burst = 0;
+    t->slow_shift = 0;
+    /* A chegada em t0 é a atual; agenda a seguinte */
+    t->next_us = t->t0_us + traffic_next_gap_us(t, t->t0_us);
+}
+
+static uint32_t xorshift32(uint32_t *s) {
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+/* Uniforme em (0, 1] */
+static float uniform(traffic_t *t) {
+    return (float)((xorshift32(&t->rng) >> 8) + 1) / 16777216.0f;
+}
+
+static uint32_t gap_constant(float rate_hz) {
+    if (rate_hz < TRAFFIC_MIN_RATE_HZ) {
+        rate_hz = TRAFFIC_MIN_RATE_HZ;
+    }
+    return (uint32_t)(1e6f / rate_hz);
+}
+
+static uint32_t gap_exponential(traffic_t *t, float rate_hz) {
+    if (rate_hz < TRAFFIC_MIN_RATE_HZ) {
+        rate_hz = TRAFFIC_MIN_RATE_HZ;
+    }
+    return (uint32_t)(-logf(uniform(t)) * 1e6f / rate_hz);
+}
+
+uint32_t traffic_next_gap_us(traffic_t *t, int64_t at_us) {
+    const traffic_cfg_t *c = &t->cfg;
+    uint64_t elapsed_ms = (uint64_t)(at_us - t->t0_us) / 1000;
+
+    switch (c->profile) {
+    case TRAFFIC_POISSON:
+        return gap_exponential(t, c->rate_hz);
+
+    case TRAFFIC_BURSTY: {
+        uint32_t period = c->on_ms + c->off_ms;
+        uint32_t pos = period ? (uint32_t)(elapsed_ms % period) : 0;
+        uint32_t gap = gap_constant(c->rate_hz);
+        /* Próxima chegada cairia no "off": pula para o início do próximo "on" */
+        if ((uint64_t)pos * 1000 + gap >= (uint64_t)c->on_ms * 1000) {
+            gap = (period - pos) * 1000;
+        }
+        return gap;
+    }
+
+    case TRAFFIC_DIURNAL: {
+        float phase = 2.0f * (float)M_PI * (float)(elapsed_ms % ((uint64_t)c->period_s * 1000))
+                    / ((float)c->period_s * 1000.0f);
+        return gap_exponential(t, c->rate_hz + c->amplitude_hz * sinf(phase));
+    }
+
+    case TRAFFIC_STEP: {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < c->n_steps; i++) {
+            total += c->steps[i].duration_ms;
+        }
+        uint64_t pos = total ? elapsed_ms % total : 0;
+        for (uint32_t i = 0; i < c->n_steps; i++) {
+            if (pos < c->steps[i].duration_ms) {
+                return gap_constant(c->steps[i].rate_hz);
+            }
+            pos -= c->steps[i].duration_ms;
+        }
+        return gap_constant(c->rate_hz);
+    }
+
+    case TRAFFIC_CONSTANT:
+    default:
+        return gap_constant(c->rate_hz);
+    }
+}
+
+int64_t traffic_advance(traffic_t *t) {
+    int64_t now = esp_timer_get_time();
+    if (now - t->next_us > TRAFFIC_MAX_LAG_US) {
+        t->next_us = now;  // fonte ficou parada (ex.: recriação): não dispara o atraso todo
+    }
+
+    int64_t due = t->next_us;
+    t->next_us += (int64_t)traffic_next_gap_us(t, due) << t->slow_shift;
+    return due;
+}
+
+void traffic_wait_next(traffic_t *t, uint32_t max_sleep_ms, void (*on_slice)(void)) {
+    /* Agenda já a chegada seguinte: ao voltar, next_us é o próximo despertar */
+    int64_t wait_us = traffic_advance(t) - esp_timer_get_time();
+    TickType_t ticks = wait_us > 0 ? (TickType_t)((wait_us + TICK_US / 2) / TICK_US) : 0;
+
+    if (ticks == 0 && ++t->burst < TRAFFIC_MAX_BURST) {
+        return;
+    }
+    t->burst = 0;
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    TickType_t slice = pdMS_TO_TICKS(max_sleep_ms) ? pdMS_TO_TICKS(max_sleep_ms) : 1;
+    while (ticks > slice) {
+        vTaskDelay(slice);
+        ticks -= slice;
+        if (on_slice) {
+            on_slice();
+        }
+    }
+    vTaskDelay(ticks);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+/* ==========================
+ *  Perfis de tráfego sintético para a fonte (task_generator)
+ *  Cada perfil define o intervalo até a próxima chegada; o PRNG é semeado
+ *  (xorshift32), então a mesma semente reproduz a mesma sequência.
+ *
+ *  TRAFFIC_CONSTANT  taxa fixa
+ *  TRAFFIC_POISSON   chegadas de Poisson (intervalos exponenciais)
+ *  TRAFFIC_BURSTY    on/off: taxa `rate_hz` por `on_ms`, silêncio por `off_ms`
+ *  TRAFFIC_DIURNAL   Poisson com taxa senoidal base ± amplitude, período `period_s`
+ *  TRAFFIC_STEP      degraus de taxa (tabela duração/taxa, repete)
+ * ========================== */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    TRAFFIC_CONSTANT = 0,
+    TRAFFIC_POISSON,
+    TRAFFIC_BURSTY,
+    TRAFFIC_DIURNAL,
+    TRAFFIC_STEP,
+} traffic_profile_t;
+
+#define TRAFFIC_MAX_STEPS   8
+
+typedef struct {
+    uint32_t duration_ms;
+    float rate_hz;
+} traffic_step_t;
+
+typedef struct {
+    traffic_profile_t profile;
+    uint32_t seed;
+    float rate_hz;                 // CONSTANT, POISSON, BURSTY (taxa no "on"), DIURNAL (base)
+    uint32_t on_ms, off_ms;        // BURSTY
+    float amplitude_hz;            // DIURNAL
+    uint32_t period_s;             // DIURNAL
+    uint32_t n_steps;              // STEP
+    traffic_step_t steps[TRAFFIC_MAX_STEPS];
+} traffic_cfg_t;
+
+typedef struct {
+    traffic_cfg_t cfg;
+    uint32_t rng;
+    int64_t t0_us;                 // início do perfil
+    int64_t next_us;               // próxima chegada ainda não atendida
+    uint32_t burst;                // chegadas seguidas sem bloquear
+    uint32_t slow_shift;           // intervalo << slow_shift (degradação, shed.h)
+} traffic_t;
+
+/* Configuração vinda de app_config.h (APP_TRAFFIC_*) */
+void traffic_default_cfg(traffic_cfg_t *cfg);
+
+void traffic_init(traffic_t *t, const traffic_cfg_t *cfg);
+
+/* Intervalo (µs) da chegada em `at_us` até a próxima */
+uint32_t traffic_next_gap_us(traffic_t *t, int64_t at_us);
+
+/* Reduz a taxa do perfil por 2^shift (0 = taxa configurada) */
+static inline void traffic_set_slowdown(traffic_t *t, uint32_t shift) {
+    t->slow_shift = shift;
+}
+
+/* Avança o agendamento sem bloquear: retorna o instante (esp_timer) da
+ * chegada pendente e agenda a seguinte. Base de traffic_wait_next e de
+ * quem não pode bloquear (corrotinas). */
+int64_t traffic_advance(traffic_t *t);
+
+/* Bloqueia até a chegada agendada e agenda a seguinte (granularidade de 1 tick;
+ * chegadas dentro do mesmo tick saem em rajada, limitada a
+ * TRAFFIC_MAX_BURST para não monopolizar o núcleo). O intervalo não tem
+ * teto (off do bursty, vale do diurnal, degradação): dorme em fatias de
+ * até `max_sleep_ms` e chama `on_slice` entre elas (batidas de WDT). */
+void traffic_wait_next(traffic_t *t, uint32_t max_sleep_ms, void (*on_slice)(void));
+
+#ifdef __cplusplus
+}
+#endif
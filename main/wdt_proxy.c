@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+#include "wdt_proxy.h"
+
+#if APP_WDT_PROXY
+
+/* ==========================
+ *  PARÂMETROS DO PROXY
+ * ========================== */
+#define WDT_PROXY_CHECK_MS       250
+#define WDT_PROXY_PRIO           (tskIDLE_PRIORITY + 1)
+#define WDT_PROXY_STACK_WORDS    2048
+
+static const char *const k_stage_names[STAGE_COUNT] = {
+    [STAGE_GEN] = "GERADOR",
+    [STAGE_RX]  = "RX",
+    [STAGE_SUP] = "SUP",
+    [STAGE_LOG] = "LOG",
+};
+
+volatile uint32_t g_wdt_beats[STAGE_COUNT];
+static volatile bool s_active[STAGE_COUNT];
+
+void wdt_subscribe(stage_id_t stage) {
+    s_active[stage] = true;
+}
+
+void wdt_unsubscribe(stage_id_t stage) {
+    s_active[stage] = false;
+}
+
+static void task_wdt_proxy(void *pv) {
+    esp_task_wdt_add(NULL);
+
+    uint32_t seen[STAGE_COUNT];
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        seen[i] = g_wdt_beats[i];
+    }
+    TickType_t last_feed = xTaskGetTickCount();
+    bool warned = false;
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(WDT_PROXY_CHECK_MS));
+
+        bool all = true;
+        for (int i = 0; i < STAGE_COUNT; i++) {
+            if (s_active[i] && g_wdt_beats[i] == seen[i]) {
+                all = false;
+            }
+        }
+
+        if (all) {
+            esp_task_wdt_reset();
+            for (int i = 0; i < STAGE_COUNT; i++) {
+                seen[i] = g_wdt_beats[i];
+            }
+            last_feed = xTaskGetTickCount();
+            warned = false;
+        } else if (!warned && xTaskGetTickCount() - last_feed > pdMS_TO_TICKS(WDT_TIMEOUT_SECONDS * 500)) {
+            /* O WDT só vai citar a alimentadora: registra quem travou */
+            for (int i = 0; i < STAGE_COUNT; i++) {
+                if (s_active[i] && g_wdt_beats[i] == seen[i]) {
+                    PRINTF("[WDT] %s sem heartbeat há %u ms.\n", k_stage_names[i],
+                           (unsigned)((xTaskGetTickCount() - last_feed) * portTICK_PERIOD_MS));
+                }
+            }
+            warned = true;
+        }
+    }
+}
+
+void wdt_proxy_start(void) {
+    xTaskCreatePinnedToCore(task_wdt_proxy, "task_wdt_proxy", WDT_PROXY_STACK_WORDS, NULL,
+                            WDT_PROXY_PRIO, NULL, APP_PIPE_CORE);
+}
+
+#endif // APP_WDT_PROXY
@@ -0,0 +1,54 @@
+#pragma once
+
+/* ==========================
+ *  Proxy de heartbeat para o Task WDT
+ *  Os estágios só incrementam um contador próprio (wdt_beat: um
+ *  load/store, sem spinlock nem busca na lista do WDT). Uma única tarefa
+ *  alimentadora, registrada no Task WDT e com prioridade logo acima do
+ *  idle no núcleo da pipeline, alimenta o WDT quando TODOS os estágios
+ *  inscritos avançaram desde a última alimentação. Estágio parado ou
+ *  núcleo monopolizado → sem alimentação → o WDT dispara como antes.
+ *
+ *  Inscrição por estágio (não por handle): a tarefa recriada pelo
+ *  supervisor continua no mesmo contador.
+ *  APP_WDT_PROXY=0 volta a chamar esp_task_wdt_* direto.
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_task_wdt.h"
+
+#include "app_config.h"
+#include "metrics.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if APP_WDT_PROXY
+
+/* Um escritor por contador (o próprio estágio) */
+extern volatile uint32_t g_wdt_beats[STAGE_COUNT];
+
+/* Cria a tarefa alimentadora. Chamar depois de esp_task_wdt_init. */
+void wdt_proxy_start(void);
+void wdt_subscribe(stage_id_t stage);
+void wdt_unsubscribe(stage_id_t stage);
+
+static inline void wdt_beat(stage_id_t stage) {
+    g_wdt_beats[stage]++;
+}
+
+#else
+
+static inline void wdt_proxy_start(void) {}
+static inline void wdt_subscribe(stage_id_t stage) { (void)stage; esp_task_wdt_add(NULL); }
+static inline void wdt_unsubscribe(stage_id_t stage) { (void)stage; esp_task_wdt_delete(NULL); }
+static inline void wdt_beat(stage_id_t stage) { (void)stage; esp_task_wdt_reset(); }
+
+#endif // APP_WDT_PROXY
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,192 @@
+#include <stdatomic.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "app_config.h"
+#include "wpool.h"
+
+#define WPOOL_STACK_WORDS    4096
+#define WPOOL_IDLE_TICKS     1     // reexamina as deques mesmo sem aviso
+
+/* ==========================
+ *  Deque limitada (anel) com trava própria
+ *  head = início (retirada), tail = fim (submissão); índices monotônicos.
+ * ========================== */
+typedef struct {
+    portMUX_TYPE lock;
+    uint32_t head;
+    uint32_t tail;
+    wpool_task_t slots[WPOOL_DEQUE_LEN];
+} wpool_deque_t;
+
+static bool dq_push_tail(wpool_deque_t *dq, const wpool_task_t *t) {
+    bool ok = false;
+    portENTER_CRITICAL(&dq->lock);
+    if (dq->tail - dq->head < WPOOL_DEQUE_LEN) {
+        dq->slots[dq->tail % WPOOL_DEQUE_LEN] = *t;
+        dq->tail++;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&dq->lock);
+    return ok;
+}
+
+static bool dq_take_head(wpool_deque_t *dq, wpool_task_t *out) {
+    bool ok = false;
+    portENTER_CRITICAL(&dq->lock);
+    if (dq->tail != dq->head) {
+        *out = dq->slots[dq->head % WPOOL_DEQUE_LEN];
+        dq->head++;
+        ok = true;
+    }
+    portEXIT_CRITICAL(&dq->lock);
+    return ok;
+}
+
+/* ==========================
+ *  Estado do pool
+ * ========================== */
+typedef struct {
+    wpool_deque_t dq;
+    wpool_stats_t stats;
+    TaskHandle_t task;
+} wpool_worker_t;
+
+static wpool_worker_t s_w[WPOOL_MAX_WORKERS];
+static int s_n = 0;
+static atomic_uint s_pending;          // submetidas e ainda não concluídas
+static atomic_uint s_queued;           // ainda paradas em alguma deque
+static atomic_uint s_sleeping;         // bit i = worker i esperando trabalho
+static atomic_int  s_alive;
+static volatile bool s_stop = false;
+static TaskHandle_t s_idle_waiter = NULL;
+
+static bool steal(int self, wpool_task_t *out) {
+    for (int k = 1; k < s_n; k++) {
+        if (dq_take_head(&s_w[(self + k) % s_n].dq, out)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void task_worker(void *pv) {
+    int self = (int)(intptr_t)pv;
+    wpool_worker_t *me = &s_w[self];
+    wpool_task_t t;
+
+    for (;;) {
+        bool own = dq_take_head(&me->dq, &t);
+        if (own || steal(self, &t)) {
+            atomic_fetch_sub(&s_queued, 1);
+            if (!own) {
+                me->stats.stolen++;
+            }
+            t.fn(&t, self);
+            me->stats.executed++;
+            me->stats.records += t.count;
+            if (atomic_fetch_sub(&s_pending, 1) == 1 && s_idle_waiter) {
+                xTaskNotifyGive(s_idle_waiter);
+            }
+            continue;
+        }
+        if (s_stop) {
+            break;
+        }
+
+        /* Avisa que vai dormir e reconfere antes (aviso perdido = 1 tick) */
+        atomic_fetch_or(&s_sleeping, 1u << self);
+        if (atomic_load(&s_queued) == 0) {
+            ulTaskNotifyTake(pdTRUE, WPOOL_IDLE_TICKS);
+        }
+        atomic_fetch_and(&s_sleeping, ~(1u << self));
+    }
+
+    atomic_fetch_sub(&s_alive, 1);
+    vTaskDelete(NULL);
+}
+
+bool wpool_submit(int worker, const wpool_task_t *task) {
+    atomic_fetch_add(&s_pending, 1);
+    atomic_fetch_add(&s_queued, 1);
+    if (!dq_push_tail(&s_w[worker].dq, task)) {
+        atomic_fetch_sub(&s_queued, 1);
+        atomic_fetch_sub(&s_pending, 1);
+        return false;
+    }
+
+    /* Acorda o dono; se ele já estiver ocupado, acorda um ocioso para roubar */
+    unsigned sleeping = atomic_load(&s_sleeping);
+    if (sleeping & (1u << worker)) {
+        xTaskNotifyGive(s_w[worker].task);
+    } else if (sleeping) {
+        for (int i = 0; i < s_n; i++) {
+            if (sleeping & (1u << i)) {
+                xTaskNotifyGive(s_w[i].task);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool wpool_wait_idle(TickType_t wait) {
+    TickType_t start = xTaskGetTickCount();
+    s_idle_waiter = xTaskGetCurrentTaskHandle();
+    while (atomic_load(&s_pending) != 0) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (wait != portMAX_DELAY && elapsed >= wait) {
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, 1);
+    }
+    s_idle_waiter = NULL;
+    return atomic_load(&s_pending) == 0;
+}
+
+bool wpool_start(int n, UBaseType_t prio) {
+    if (n < 1 || n > WPOOL_MAX_WORKERS || atomic_load(&s_alive) != 0) {
+        return false;
+    }
+    memset(s_w, 0, sizeof(s_w));
+    for (int i = 0; i < n; i++) {
+        s_w[i].dq.lock = (portMUX_TYPE)portMUX_INITIALIZER_UNLOCKED;
+    }
+    s_n = n;
+    s_stop = false;
+    atomic_store(&s_pending, 0);
+    atomic_store(&s_queued, 0);
+    atomic_store(&s_sleeping, 0);
+
+    for (int i = 0; i < n; i++) {
+        atomic_fetch_add(&s_alive, 1);
+        if (xTaskCreatePinnedToCore(task_worker, "task_worker", WPOOL_STACK_WORDS,
+                                    (void *)(intptr_t)i, prio, &s_w[i].task,
+                                    (APP_PIPE_CORE + i) % APP_NUM_CORES) != pdPASS) {
+            atomic_fetch_sub(&s_alive, 1);
+            wpool_stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+void wpool_stop(void) {
+    s_stop = true;
+    while (atomic_load(&s_alive) != 0) {
+        vTaskDelay(1);
+    }
+    s_n = 0;
+}
+
+int wpool_workers(void) {
+    return s_n;
+}
+
+void wpool_get_stats(int worker, wpool_stats_t *out) {
+    out->executed = s_w[worker].stats.executed;
+    out->stolen = s_w[worker].stats.stolen;
+    out->records = s_w[worker].stats.records;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/* ==========================
+ *  Pool de workers com roubo de trabalho
+ *  Um worker por núcleo, cada um com sua própria deque limitada:
+ *    - a fonte submete no fim;
+ *    - o dono e os ladrões retiram do início (a tarefa mais antiga).
+ *      Retirada em ordem de submissão mantém os registros em voo perto
+ *      da cabeça da sequência, o que o buffer de reordenação (rob.h)
+ *      precisa para não esgotar a janela.
+ *    - um worker ocioso rouba da deque de outro.
+ *  Cada deque tem sua própria trava curta (portMUX): não existe trava
+ *  global, e dois workers só disputam quando um está roubando do outro.
+ *
+ *  A fonte submete registros (ou lotes de registros) como tarefas nas
+ *  deques dos workers em rodízio; o roubo só entra quando um worker
+ *  esvazia a própria deque antes dos outros (desbalanceamento real).
+ * ========================== */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "app_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WPOOL_MAX_WORKERS   APP_NUM_CORES
+#define WPOOL_DEQUE_LEN     32
+
+typedef struct wpool_task wpool_task_t;
+typedef void (*wpool_fn_t)(const wpool_task_t *task, int worker);
+
+/* Tarefa: lote de `count` registros consecutivos a partir de `first` */
+struct wpool_task {
+    wpool_fn_t fn;
+    int32_t    first;
+    uint32_t   count;
+    uint32_t   t_enq_us;   // carimbo de submissão (metrics_now_us)
+};
+
+/* Contadores de um worker (único escritor: o próprio worker) */
+typedef struct {
+    volatile uint32_t executed;   // tarefas executadas (próprias + roubadas)
+    volatile uint32_t stolen;     // tarefas obtidas por roubo
+    volatile uint32_t records;    // registros processados
+} wpool_stats_t;
+
+/* Cria n workers (1..WPOOL_MAX_WORKERS); o worker 0 fica no núcleo da
+ * pipeline e os seguintes nos outros núcleos. Contadores zerados. */
+bool wpool_start(int n, UBaseType_t prio);
+
+/* Espera os workers esvaziarem as deques e encerrarem */
+void wpool_stop(void);
+
+/* Submete na deque do worker indicado, sem bloquear.
+ * Retorna false se a deque estiver cheia (contrapressão para a fonte). */
+bool wpool_submit(int worker, const wpool_task_t *task);
+
+/* Bloqueia até todas as tarefas submetidas terminarem ou `wait` expirar */
+bool wpool_wait_idle(TickType_t wait);
+
+int  wpool_workers(void);
+void wpool_get_stats(int worker, wpool_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif